@@ -3,6 +3,10 @@
  */
 
 #include "Charinfo.h"
+#include "PackedUpdates.h"
+#include "ProtoEquality.h"
+#include "SharedSnapshots.h"
+#include "SpellCache.h"
 #include "mq/Plugin.h"
 #include <mq/base/String.h>
 
@@ -10,9 +14,14 @@
 #include <eqlib/game/EQData.h>
 #include <eqlib/game/Spells.h>
 
+#include <algorithm>
+#include <array>
+#include <chrono>
 #include <cmath>
 #include <cstdio>
+#include <cstdlib>
 #include <string_view>
+#include <type_traits>
 #include <vector>
 
 namespace charinfo {
@@ -142,15 +151,247 @@ PeerMap& GetPeers() {
 	return s_peers;
 }
 
-static void SetZoneDistanceFromLocal(PeerZoneInfo& zone)
+float MinPeerVersion()
 {
-	if (!pLocalPlayer || !pLocalPC) return;
-	if (pLocalPC->zoneId != zone.id) return;
-	if (static_cast<uint16_t>(pLocalPC->instance) != static_cast<uint16_t>(zone.instance_id)) return;
-	float dX = pLocalPlayer->X - zone.x;
-	float dY = pLocalPlayer->Y - zone.y;
-	float dZ = pLocalPlayer->Z - zone.z;
-	zone.distance = static_cast<double>(std::sqrtf(dX * dX + dY * dY + dZ * dZ));
+	float version = CHARINFO_VERSION;
+	for (const auto& entry : s_peers) {
+		if (entry.second && entry.second->version < version)
+			version = entry.second->version;
+	}
+	return version;
+}
+
+static PublishStats s_publishStats;
+
+PublishStats& GetPublishStats() {
+	return s_publishStats;
+}
+
+int64_t ClockMs()
+{
+	return std::chrono::duration_cast<std::chrono::milliseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+int32_t PeerBuffEntry::Remaining() const
+{
+	if (expires_at == 0)
+		return duration;
+	return static_cast<int32_t>(std::max<int64_t>(0, expires_at - ClockMs()));
+}
+
+// Sender-clock expiry to local clock; 0 (permanent / unknown) stays 0.
+static int64_t ToLocalExpiry(int64_t senderExpiry, int64_t clockOffset)
+{
+	return senderExpiry == 0 ? 0 : senderExpiry + clockOffset;
+}
+
+// A compact SpellInfo (1.8+) carries only the ID; the rest is resolved from the local spell data
+// the same way gems are, with the level for the owner's class.
+static PeerSpellInfo ToPeerSpell(const mq::proto::charinfo::SpellInfo& spell, int32_t classId)
+{
+	PeerSpellInfo out;
+	out.id = spell.id();
+	if (!spell.name().empty()) {
+		out.name = spell.name();
+		out.category = spell.category();
+		out.level = spell.level();
+	} else if (const SpellMeta* meta = GetSpellMeta(spell.id())) {
+		out.name = meta->name;
+		out.category = meta->category;
+		out.level = meta->Level(classId);
+	}
+	return out;
+}
+
+static PeerBuffEntry ToPeerBuffEntry(const mq::proto::charinfo::SpellInfo& spell, int32_t classId,
+	int64_t senderExpiry, int64_t clockOffset)
+{
+	PeerBuffEntry e;
+	e.spell = ToPeerSpell(spell, classId);
+	e.expires_at = ToLocalExpiry(senderExpiry, clockOffset);
+	return e;
+}
+
+static PeerLuaScriptInfo ToPeerLuaScript(const mq::proto::charinfo::LuaScriptInfo& src)
+{
+	PeerLuaScriptInfo dst;
+	dst.pid = src.pid();
+	dst.name = src.name();
+	dst.path = src.path();
+	dst.status = src.status();
+	dst.arguments.reserve(static_cast<size_t>(src.arguments_size()));
+	for (int arg = 0; arg < src.arguments_size(); ++arg)
+		dst.arguments.push_back(src.arguments(arg));
+	return dst;
+}
+
+// PositionInfo fixed point: coordinates, velocity and heading in tenths.
+static constexpr float kPositionScale = 10.0f;
+// A fix is extrapolated at most this long; a peer that stopped sending is not run off across the zone.
+static constexpr int64_t kMaxExtrapolationMs = 3000;
+
+static float ExtrapolateAxis(float base, float velocity, int64_t fixMs)
+{
+	if (fixMs == 0 || velocity == 0.0f)
+		return base;
+	const int64_t elapsed = std::clamp<int64_t>(ClockMs() - fixMs, 0, kMaxExtrapolationMs);
+	return base + velocity * static_cast<float>(elapsed) / 1000.0f;
+}
+
+float PeerZoneInfo::X() const { return ExtrapolateAxis(x, vx, fix_ms); }
+float PeerZoneInfo::Y() const { return ExtrapolateAxis(y, vy, fix_ms); }
+float PeerZoneInfo::Z() const { return ExtrapolateAxis(z, vz, fix_ms); }
+
+double ZoneDistance(const PeerZoneInfo& zone)
+{
+	if (!pLocalPlayer || !pLocalPC) return -1.0;
+	if (pLocalPC->zoneId != zone.id) return -1.0;
+	if (static_cast<uint16_t>(pLocalPC->instance) != static_cast<uint16_t>(zone.instance_id)) return -1.0;
+	float dX = pLocalPlayer->X - zone.X();
+	float dY = pLocalPlayer->Y - zone.Y();
+	float dZ = pLocalPlayer->Z - zone.Z();
+	return static_cast<double>(std::sqrtf(dX * dX + dY * dY + dZ * dZ));
+}
+
+// Zone position as sent in ZoneInfo: no velocity.
+static void SetZonePosition(PeerZoneInfo& zone, const mq::proto::charinfo::ZoneInfo& src)
+{
+	zone.x = src.x();
+	zone.y = src.y();
+	zone.z = src.z();
+	zone.heading = src.heading();
+	zone.vx = zone.vy = zone.vz = 0;
+	zone.fix_ms = 0;
+}
+
+// Dead-reckoning fix (2.5+); at_ms is on the sender clock.
+static void ApplyPositionFix(PeerZoneInfo& zone, const mq::proto::charinfo::PositionInfo& pos, int64_t clockOffset)
+{
+	zone.x = static_cast<float>(pos.x()) / kPositionScale;
+	zone.y = static_cast<float>(pos.y()) / kPositionScale;
+	zone.z = static_cast<float>(pos.z()) / kPositionScale;
+	zone.heading = static_cast<float>(pos.heading()) / kPositionScale;
+	zone.vx = static_cast<float>(pos.vx()) / kPositionScale;
+	zone.vy = static_cast<float>(pos.vy()) / kPositionScale;
+	zone.vz = static_cast<float>(pos.vz()) / kPositionScale;
+	zone.fix_ms = pos.at_ms() == 0 ? 0 : pos.at_ms() + clockOffset;
+}
+
+// Gem entry from spell ID alone, resolved against the local spell data.
+static PeerGemEntry ResolveGem(int32_t spellId, PcProfile* profile)
+{
+	PeerGemEntry ge;
+	ge.id = spellId;
+	if (const SpellMeta* meta = GetSpellMeta(spellId)) {
+		ge.name = meta->name;
+		ge.category = meta->category;
+		ge.level = profile ? meta->Level(profile->Class) : 0;
+	}
+	return ge;
+}
+
+// --- Session strings (2.6+) ---
+
+// Tokens above this are never assigned; the sender starts over at 1 when it runs out.
+static constexpr uint32_t kMaxSessionStrings = 1024;
+
+// The strings that may travel as session string tokens, in wire order (see string_tokens).
+template <typename Visit>
+static void ForEachPublishString(const mq::proto::charinfo::CharinfoPublish& pub, Visit&& visit)
+{
+	visit(pub.class_info().name());
+	visit(pub.class_info().short_name());
+	visit(pub.target().name());
+	visit(pub.zone().name());
+	visit(pub.zone().short_name());
+	visit(pub.macro().macro_name());
+	for (const auto& script : pub.lua().scripts()) {
+		visit(script.name());
+		visit(script.path());
+	}
+}
+
+template <typename Visit>
+static void ForEachUpdateString(mq::proto::charinfo::CharinfoUpdate* update, Visit&& visit)
+{
+	using Value = mq::proto::charinfo::FieldUpdate::ValueCase;
+	for (auto& u : *update->mutable_updates()) {
+		switch (u.value_case()) {
+		case Value::kClassInfo:
+			visit(u.mutable_class_info()->mutable_name());
+			visit(u.mutable_class_info()->mutable_short_name());
+			break;
+		case Value::kTarget:
+			visit(u.mutable_target()->mutable_name());
+			break;
+		case Value::kZone:
+			visit(u.mutable_zone()->mutable_name());
+			visit(u.mutable_zone()->mutable_short_name());
+			break;
+		case Value::kMacro:
+			visit(u.mutable_macro()->mutable_macro_name());
+			break;
+		case Value::kLua:
+			for (auto& script : *u.mutable_lua()->mutable_scripts()) {
+				visit(script.mutable_name());
+				visit(script.mutable_path());
+			}
+			break;
+		case Value::kLuaDelta:
+			for (auto& script : *u.mutable_lua_delta()->mutable_upsert()) {
+				visit(script.mutable_name());
+				visit(script.mutable_path());
+			}
+			break;
+		default: break;
+		}
+	}
+}
+
+static void DefineSessionString(CharinfoPeer* peer, uint32_t token, const std::string& value)
+{
+	if (peer->session_strings.size() <= token)
+		peer->session_strings.resize(static_cast<size_t>(token) + 1);
+	peer->session_strings[token] = value;
+}
+
+// A full publish carries every string inline: the sender's table is exactly its tokens.
+static void RebuildSessionStrings(const mq::proto::charinfo::CharinfoPublish& pub, CharinfoPeer* peer)
+{
+	peer->session_strings.clear();
+	int slot = 0;
+	ForEachPublishString(pub, [&](const std::string& value) {
+		if (slot >= pub.string_tokens_size())
+			return;
+		const uint32_t token = pub.string_tokens(slot++);
+		if (token != 0 && token <= kMaxSessionStrings && !value.empty())
+			DefineSessionString(peer, token, value);
+	});
+}
+
+bool ResolveSessionStrings(mq::proto::charinfo::CharinfoUpdate* update, CharinfoPeer* peer)
+{
+	if (update->string_tokens_size() == 0)
+		return true;
+	bool resolved = true;
+	int slot = 0;
+	ForEachUpdateString(update, [&](std::string* value) {
+		if (slot >= update->string_tokens_size())
+			return;
+		const uint32_t token = update->string_tokens(slot++);
+		if (token == 0)
+			return;
+		if (token > kMaxSessionStrings)
+			resolved = false;
+		else if (!value->empty())
+			DefineSessionString(peer, token, *value);
+		else if (token < peer->session_strings.size() && !peer->session_strings[token].empty())
+			*value = peer->session_strings[token];
+		else
+			resolved = false;
+	});
+	return resolved;
 }
 
 CharinfoPeer FromPublish(const mq::proto::charinfo::CharinfoPublish& pub)
@@ -188,6 +429,9 @@ CharinfoPeer FromPublish(const mq::proto::charinfo::CharinfoPublish& pub)
 	p.casting_spell_id = pub.casting_spell_id();
 	p.combat_state = pub.combat_state();
 	p.version = pub.version();
+	if (pub.clock_ms() != 0)
+		p.clock_offset = ClockMs() - pub.clock_ms();
+	p.seq = pub.seq();
 
 	p.class_info.name = pub.class_info().name();
 	p.class_info.short_name = pub.class_info().short_name();
@@ -200,12 +444,10 @@ CharinfoPeer FromPublish(const mq::proto::charinfo::CharinfoPublish& pub)
 	p.zone.short_name = pub.zone().short_name();
 	p.zone.id = pub.zone().id();
 	p.zone.instance_id = pub.zone().instance_id();
-	p.zone.x = pub.zone().x();
-	p.zone.y = pub.zone().y();
-	p.zone.z = pub.zone().z();
-	p.zone.heading = pub.zone().heading();
-	p.zone.distance = -1.0;
-	SetZoneDistanceFromLocal(p.zone);
+	if (pub.has_position())
+		ApplyPositionFix(p.zone, pub.position(), p.clock_offset);
+	else
+		SetZonePosition(p.zone, pub.zone());
 
 	const int buffSize = pub.buff_spells_size();
 	const int durSize = pub.buff_durations_size();
@@ -213,11 +455,10 @@ CharinfoPeer FromPublish(const mq::proto::charinfo::CharinfoPublish& pub)
 	p.buff.reserve(static_cast<size_t>(buffSize));
 	for (int i = 0; i < buffSize; i++) {
 		PeerBuffEntry e;
-		e.spell.name = pub.buff_spells(i).name();
-		e.spell.id = pub.buff_spells(i).id();
-		e.spell.category = pub.buff_spells(i).category();
-		e.spell.level = pub.buff_spells(i).level();
+		e.spell = ToPeerSpell(pub.buff_spells(i), p.class_info.id);
 		e.duration = (i < durSize) ? pub.buff_durations(i) : -1;
+		if (i < pub.buff_expires_size())
+			e.expires_at = ToLocalExpiry(pub.buff_expires(i), p.clock_offset);
 		p.buff.push_back(std::move(e));
 	}
 	const int shortSpellSize = pub.short_buff_spells_size();
@@ -226,11 +467,10 @@ CharinfoPeer FromPublish(const mq::proto::charinfo::CharinfoPublish& pub)
 	p.short_buff.reserve(static_cast<size_t>(shortSpellSize));
 	for (int i = 0; i < shortSpellSize; i++) {
 		PeerBuffEntry e;
-		e.spell.name = pub.short_buff_spells(i).name();
-		e.spell.id = pub.short_buff_spells(i).id();
-		e.spell.category = pub.short_buff_spells(i).category();
-		e.spell.level = pub.short_buff_spells(i).level();
+		e.spell = ToPeerSpell(pub.short_buff_spells(i), p.class_info.id);
 		e.duration = (i < shortDurSize) ? pub.short_buff_durations(i) : -1;
+		if (i < pub.short_buff_expires_size())
+			e.expires_at = ToLocalExpiry(pub.short_buff_expires(i), p.clock_offset);
 		p.short_buff.push_back(std::move(e));
 	}
 	const int petSpellSize = pub.pet_buff_spells_size();
@@ -239,11 +479,10 @@ CharinfoPeer FromPublish(const mq::proto::charinfo::CharinfoPublish& pub)
 	p.pet_buff.reserve(static_cast<size_t>(petSpellSize));
 	for (int i = 0; i < petSpellSize; i++) {
 		PeerBuffEntry e;
-		e.spell.name = pub.pet_buff_spells(i).name();
-		e.spell.id = pub.pet_buff_spells(i).id();
-		e.spell.category = pub.pet_buff_spells(i).category();
-		e.spell.level = pub.pet_buff_spells(i).level();
+		e.spell = ToPeerSpell(pub.pet_buff_spells(i), p.class_info.id);
 		e.duration = (i < petDurSize) ? pub.pet_buff_durations(i) : -1;
+		if (i < pub.pet_buff_expires_size())
+			e.expires_at = ToLocalExpiry(pub.pet_buff_expires(i), p.clock_offset);
 		p.pet_buff.push_back(std::move(e));
 	}
 
@@ -253,20 +492,8 @@ CharinfoPeer FromPublish(const mq::proto::charinfo::CharinfoPublish& pub)
 	PcProfile* profile = GetPcProfile();
 	p.gems.clear();
 	p.gems.reserve(static_cast<size_t>(pub.gem_size()));
-	for (int i = 0; i < pub.gem_size(); i++) {
-		PeerGemEntry ge;
-		ge.id = pub.gem(i);
-		if (EQ_Spell* spell = GetSpellByID(pub.gem(i))) {
-			ge.name = spell->Name[0] ? spell->Name : "";
-			ge.category = spell->Category;
-			ge.level = profile ? static_cast<int32_t>(spell->GetSpellLevelNeeded(profile->Class)) : 0;
-		} else {
-			ge.name = "";
-			ge.category = 0;
-			ge.level = 0;
-		}
-		p.gems.push_back(std::move(ge));
-	}
+	for (int i = 0; i < pub.gem_size(); i++)
+		p.gems.push_back(ResolveGem(pub.gem(i), profile));
 
 	p.free_inventory.clear();
 	p.free_inventory.reserve(static_cast<size_t>(pub.free_inventory_size()));
@@ -311,54 +538,658 @@ CharinfoPeer FromPublish(const mq::proto::charinfo::CharinfoPublish& pub)
 	if (pub.has_lua()) {
 		PeerLuaInfo lua;
 		lua.scripts.reserve(static_cast<size_t>(pub.lua().scripts_size()));
-		for (int i = 0; i < pub.lua().scripts_size(); ++i) {
-			const auto& src = pub.lua().scripts(i);
-			PeerLuaScriptInfo dst;
-			dst.pid = src.pid();
-			dst.name = src.name();
-			dst.path = src.path();
-			dst.status = src.status();
-			dst.arguments.reserve(static_cast<size_t>(src.arguments_size()));
-			for (int arg = 0; arg < src.arguments_size(); ++arg)
-				dst.arguments.push_back(src.arguments(arg));
-			lua.scripts.push_back(std::move(dst));
-		}
+		for (int i = 0; i < pub.lua().scripts_size(); ++i)
+			lua.scripts.push_back(ToPeerLuaScript(pub.lua().scripts(i)));
 		p.has_lua = true;
 		p.lua = std::move(lua);
 	} else {
 		p.has_lua = false;
 	}
+	if (pub.string_tokens_size() > 0)
+		RebuildSessionStrings(pub, &p);
 	return p;
 }
 
+void ApplySharedVitals(const SharedVitals& vitals, CharinfoPeer* peer)
+{
+	peer->current_hp = vitals.current_hp;
+	peer->max_hp = vitals.max_hp;
+	peer->pct_hps = vitals.pct_hps;
+	peer->current_mana = vitals.current_mana;
+	peer->max_mana = vitals.max_mana;
+	peer->pct_mana = vitals.pct_mana;
+	peer->current_endurance = vitals.current_endurance;
+	peer->max_endurance = vitals.max_endurance;
+	peer->pct_endurance = vitals.pct_endurance;
+	peer->no_cure = vitals.no_cure;
+	peer->life_drain = vitals.life_drain;
+	peer->mana_drain = vitals.mana_drain;
+	peer->endu_drain = vitals.endu_drain;
+	if (vitals.state_bits != peer->state_bits) {
+		peer->state_bits = vitals.state_bits;
+		peer->state = StateBitsToStrings(vitals.state_bits);
+	}
+	if (vitals.detr_state_bits != peer->detr_state_bits || vitals.bene_state_bits != peer->bene_state_bits) {
+		peer->detr_state_bits = vitals.detr_state_bits;
+		peer->bene_state_bits = vitals.bene_state_bits;
+		peer->buff_state = BuffStateBitsToStrings(vitals.detr_state_bits, vitals.bene_state_bits);
+	}
+	peer->casting_spell_id = vitals.casting_spell_id;
+	peer->combat_state = vitals.combat_state;
+	peer->target.id = vitals.target_id;
+	peer->target.name.assign(vitals.target_name);
+	peer->target_hp = vitals.target_hp;
+	if (vitals.clock_ms != 0)
+		peer->clock_offset = ClockMs() - vitals.clock_ms;
+	peer->seq = vitals.seq;
+}
+
+namespace {
+
+// FNV-1a over raw bytes; cheap enough to run on every sample to detect section changes.
+class Fingerprint {
+public:
+	void Add(const void* data, size_t size)
+	{
+		const auto* bytes = static_cast<const uint8_t*>(data);
+		for (size_t i = 0; i < size; i++) {
+			m_hash ^= bytes[i];
+			m_hash *= 1099511628211ull;
+		}
+	}
+
+	template <typename T>
+	void AddValue(const T& value)
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "AddValue requires a trivially copyable type");
+		Add(&value, sizeof(T));
+	}
+
+	void AddString(std::string_view value)
+	{
+		AddValue(value.size());
+		Add(value.data(), value.size());
+	}
+
+	uint64_t Value() const { return m_hash; }
+
+private:
+	uint64_t m_hash = 14695981039346656037ull;
+};
+
+} // namespace
+
+static const char* const kSectionNames[] = {
+	"Identity", "Vitals", "Target", "Zone", "Buffs", "BuffTimers", "Pet",
+	"Gems", "Experience", "MakeCamp", "Macro", "Lua", "Inventory",
+};
+static_assert(sizeof(kSectionNames) / sizeof(kSectionNames[0]) == static_cast<size_t>(PublishSection::Count),
+	"kSectionNames must have one entry per PublishSection");
+
+const char* SectionName(PublishSection section)
+{
+	const size_t index = static_cast<size_t>(section);
+	return index < static_cast<size_t>(PublishSection::Count) ? kSectionNames[index] : "";
+}
+
+// ClockMs() of the last local read of each section.
+static int64_t s_sectionReadAt[static_cast<size_t>(PublishSection::Count)] = {};
+
+void NoteSectionRead(SectionMask sections)
+{
+	const int64_t now = ClockMs();
+	for (size_t i = 0; i < static_cast<size_t>(PublishSection::Count); i++) {
+		if (sections & SectionBit(static_cast<PublishSection>(i)))
+			s_sectionReadAt[i] = now;
+	}
+}
+
+SectionMask RecentlyReadSections(int64_t windowMs)
+{
+	const int64_t now = ClockMs();
+	SectionMask sections = 0;
+	for (size_t i = 0; i < static_cast<size_t>(PublishSection::Count); i++) {
+		if (s_sectionReadAt[i] != 0 && now - s_sectionReadAt[i] < windowMs)
+			sections |= SectionBit(static_cast<PublishSection>(i));
+	}
+	return sections;
+}
+
+void ResetSectionReads()
+{
+	NoteSectionRead(kAllSections);
+}
+
+static bool IsValidBuffSpell(int spellId)
+{
+	return GetSpellMeta(spellId) != nullptr;
+}
+
+// Snapshots keep spells compact (ID only); ExpandSpellInfo fills the rest for pre-1.8 receivers.
+static void SetSpellInfo(mq::proto::charinfo::SpellInfo* si, const SpellMeta& meta)
+{
+	si->set_id(meta.id);
+}
+
+static void ExpandSpellInfo(mq::proto::charinfo::SpellInfo* si)
+{
+	const SpellMeta* meta = GetSpellMeta(si->id());
+	if (!meta)
+		return;
+	if (!meta->name.empty())
+		si->set_name(meta->name);
+	si->set_category(meta->category);
+	si->set_level(meta->Level(GetPcProfile()->Class));
+}
+
+void ExpandSpellInfos(mq::proto::charinfo::CharinfoPublish* publish)
+{
+	for (auto& si : *publish->mutable_buff_spells())
+		ExpandSpellInfo(&si);
+	for (auto& si : *publish->mutable_short_buff_spells())
+		ExpandSpellInfo(&si);
+	for (auto& si : *publish->mutable_pet_buff_spells())
+		ExpandSpellInfo(&si);
+}
+
+static int ReadBuffTimer(int spellId)
+{
+	int dur = static_cast<int>(GetSpellBuffTimer(spellId));
+	return dur < 0 ? -1 : dur;
+}
+
+static int ReadPetBuffTimer(int slot)
+{
+	int dur = static_cast<int>(pPetInfoWnd->GetBuffTimer(slot));
+	return dur < 0 ? -1 : dur;
+}
+
+static bool HasPetWindow()
+{
+	return pLocalPlayer->PetID && pPetInfoWnd;
+}
+
 static void AddBuffEntry(mq::proto::charinfo::CharinfoPublish* msg,
-	int spellId, int duration, bool is_long_buff, int* detrimentals)
+	int spellId, bool is_long_buff, int* detrimentals)
 {
-	EQ_Spell* spell = GetSpellByID(spellId);
-	if (!spell || spell->ID <= 0)
+	const SpellMeta* meta = GetSpellMeta(spellId);
+	if (!meta)
 		return;
 
-	auto* si = is_long_buff ? msg->add_buff_spells() : msg->add_short_buff_spells();
-	si->set_id(spell->ID);
-	if (spell->Name[0])
-		si->set_name(spell->Name);
-	si->set_category(spell->Category);
-	si->set_level(static_cast<int>(spell->GetSpellLevelNeeded(GetPcProfile()->Class)));
-	if (is_long_buff)
-		msg->add_buff_durations(duration);
-	else
-		msg->add_short_buff_durations(duration);
+	SetSpellInfo(is_long_buff ? msg->add_buff_spells() : msg->add_short_buff_spells(), *meta);
 
-	if (spell->SpellType == SpellType_Detrimental && detrimentals)
+	if (meta->detrimental && detrimentals)
 		(*detrimentals)++;
 }
 
-bool BuildPublishPayload(mq::proto::charinfo::CharinfoPublish* out)
+static uint32_t ReadStateBits()
 {
-	if (!pLocalPlayer || !GetPcProfile() || !pZoneInfo)
+	uint32_t stateBits = 0;
+	switch (pLocalPlayer->StandState) {
+		case STANDSTATE_STAND: stateBits |= StateBits::STAND; break;
+		case STANDSTATE_SIT:   stateBits |= StateBits::SIT;   break;
+		case STANDSTATE_DUCK:  stateBits |= StateBits::DUCK;  break;
+		case STANDSTATE_BIND:  stateBits |= StateBits::BIND;  break;
+		case STANDSTATE_FEIGN: stateBits |= StateBits::FEIGN; break;
+		case STANDSTATE_DEAD:  stateBits |= StateBits::DEAD;  break;
+		default: break;
+	}
+	if (pEverQuestInfo && pEverQuestInfo->bAutoAttack)
+		stateBits |= StateBits::ATTACK;
+	if (pLocalPlayer->Mount)
+		stateBits |= StateBits::MOUNT;
+	if (std::fabs(pLocalPlayer->SpeedRun) > 0.0f)
+		stateBits |= StateBits::MOVING;
+	if (pLocalPlayer->AFK)
+		stateBits |= StateBits::AFK;
+	if (pLocalPlayer->LFG)
+		stateBits |= StateBits::LFG;
+	if (pLocalPlayer->RespawnTimer != 0)
+		stateBits |= StateBits::HOVER;
+	if (pLocalPlayer->PlayerState & 0x20)
+		stateBits |= StateBits::STUN;
+	if (pLocalPlayer->mPlayerPhysicsClient.Levitate == 2)
+		stateBits |= StateBits::LEV;
+	if (pLocalPC && pLocalPC->pGroupInfo)
+		stateBits |= StateBits::GROUP;
+	if (pRaid && pRaid->RaidMemberCount)
+		stateBits |= StateBits::RAID;
+	// Invis / ITU: check HideMode or buff-based (simplified: HideMode)
+	if ((pLocalPlayer->HideMode & 0x01))
+		stateBits |= StateBits::INVIS;
+	return stateBits;
+}
+
+// MakeCamp values as read from MQ2MoveUtils; present=false when the plugin is not loaded.
+struct MakeCampState {
+	bool present = false;
+	int status = 0; // 0 = off, 1 = ON, 2 = PAUSED
+	float x = 0, y = 0, radius = 0, distance = 0;
+};
+
+static bool EvalFloatMember(const MQTypeVar& source, const char* member, float& out)
+{
+	MQTypeVar value;
+	std::string text;
+	if (!EvalMember(source, member, nullptr, value) || !TypeVarToString(value, text))
+		return false;
+	out = GetFloatFromString(text, 0.f);
+	return true;
+}
+
+// Reads the MakeCamp TLO members directly (no macro string parse). While no camp is active only
+// Status is evaluated, so the sampler sees an unchanged fingerprint and the section costs nothing.
+static MakeCampState ReadMakeCampState()
+{
+	MakeCampState state;
+	MQTopLevelObject* campTlo = FindMQ2Data("MakeCamp");
+	MQTypeVar campVar;
+	if (!campTlo || !campTlo->Function("", campVar))
+		return state;
+	state.present = true;
+
+	MQTypeVar statusVar;
+	std::string status;
+	if (!EvalMember(campVar, "Status", nullptr, statusVar) || !TypeVarToString(statusVar, status))
+		return state;
+	if (ci_equals(status, "ON"))
+		state.status = 1;
+	else if (ci_equals(status, "PAUSED"))
+		state.status = 2;
+	else
+		return state;
+
+	EvalFloatMember(campVar, "AnchorX", state.x);
+	EvalFloatMember(campVar, "AnchorY", state.y);
+	EvalFloatMember(campVar, "CampRadius", state.radius);
+	EvalFloatMember(campVar, "CampDist", state.distance);
+	return state;
+}
+
+static bool ResolveLuaTlo(MQTypeVar& luaVar)
+{
+	MQTopLevelObject* luaTlo = FindMQ2Data("Lua");
+	return luaTlo && luaTlo->Function("", luaVar);
+}
+
+namespace {
+
+// Lua section cache keyed by the Lua TLO's PID list. Per-script metadata (Name/Path/Arguments) is only
+// fetched when a PID first appears or its status changes. While the PID list is unchanged the section is
+// skipped entirely, apart from a status poll every kStatusPollSamples samples to catch pause/resume.
+class LuaScriptCache {
+public:
+	// Re-read the Lua TLO if needed. Returns true if the cached script list changed.
+	bool Refresh();
+
+	void WriteTo(mq::proto::charinfo::LuaInfo* out) const;
+
+	uint64_t Generation() const { return m_generation; }
+
+	void Reset()
+	{
+		m_pidsText.clear();
+		m_scripts.clear();
+		m_samplesSinceStatusPoll = 0;
+		m_generation++;
+	}
+
+private:
+	struct Script {
+		int pid = 0;
+		std::string status;
+		std::string name;
+		std::string path;
+		std::vector<std::string> arguments;
+	};
+
+	static constexpr uint32_t kStatusPollSamples = 3;
+
+	std::string m_pidsText;
+	std::vector<Script> m_scripts; // PID-list order, every status
+	uint32_t m_samplesSinceStatusPoll = 0;
+	uint64_t m_generation = 0;
+};
+
+bool LuaScriptCache::Refresh()
+{
+	MQTypeVar luaVar;
+	MQTypeVar pidsVar;
+	std::string pidsText;
+	if (!ResolveLuaTlo(luaVar) || !EvalMember(luaVar, "PIDs", nullptr, pidsVar) || !TypeVarToString(pidsVar, pidsText))
+		pidsText.clear();
+
+	const bool pollStatus = ++m_samplesSinceStatusPoll >= kStatusPollSamples;
+	if (pidsText == m_pidsText && !pollStatus)
 		return false;
+	m_samplesSinceStatusPoll = 0;
+	m_pidsText = pidsText;
+
+	bool changed = false;
+	std::vector<Script> next;
+	for (const std::string& pidToken : SplitCSV(pidsText)) {
+		const int pid = GetIntFromString(pidToken, 0);
+		if (pid <= 0)
+			continue;
+
+		char pidIndex[32] = { 0 };
+		sprintf_s(pidIndex, "%d", pid);
+
+		MQTypeVar scriptVar;
+		if (!EvalMember(luaVar, "Script", pidIndex, scriptVar))
+			continue;
+
+		MQTypeVar statusVar;
+		std::string status;
+		if (!EvalMember(scriptVar, "Status", nullptr, statusVar) || !TypeVarToString(statusVar, status))
+			continue;
+		mq::trim(status);
+
+		auto it = std::find_if(m_scripts.begin(), m_scripts.end(), [pid](const Script& s) { return s.pid == pid; });
+		if (it != m_scripts.end() && it->status == status) {
+			next.push_back(std::move(*it));
+			continue;
+		}
+
+		Script script;
+		script.pid = pid;
+		script.status = std::move(status);
+
+		MQTypeVar nameVar;
+		if (EvalMember(scriptVar, "Name", nullptr, nameVar))
+			TypeVarToString(nameVar, script.name);
+
+		MQTypeVar pathVar;
+		if (EvalMember(scriptVar, "Path", nullptr, pathVar))
+			TypeVarToString(pathVar, script.path);
+
+		MQTypeVar argsVar;
+		std::string argsText;
+		if (EvalMember(scriptVar, "Arguments", nullptr, argsVar) && TypeVarToString(argsVar, argsText) && !argsText.empty())
+			script.arguments = SplitCSV(argsText);
+
+		next.push_back(std::move(script));
+		changed = true;
+	}
+
+	if (next.size() != m_scripts.size())
+		changed = true;
+	for (size_t i = 0; !changed && i < next.size(); i++)
+		changed = next[i].pid != m_scripts[i].pid;
+
+	m_scripts = std::move(next);
+	if (changed)
+		m_generation++;
+	return changed;
+}
+
+void LuaScriptCache::WriteTo(mq::proto::charinfo::LuaInfo* out) const
+{
+	out->Clear();
+	for (const Script& src : m_scripts) {
+		if (src.status != "RUNNING" && src.status != "PAUSED")
+			continue;
 
+		auto* script = out->add_scripts();
+		script->set_pid(src.pid);
+		script->set_status(src.status);
+		if (!src.name.empty())
+			script->set_name(src.name);
+		if (!src.path.empty())
+			script->set_path(src.path);
+		for (const std::string& arg : src.arguments)
+			script->add_arguments(arg);
+	}
+}
+
+} // namespace
+
+static LuaScriptCache s_luaCache;
+
+
+namespace {
+
+// Free inventory slots by container size, summed over the top-level bag slots. The bags are rescanned
+// only after InvalidateInventory() (cursor moves, loot/trade/merchant messages, zoning), so publishing
+// free_inventory in steady state only reads the totals. A rescan every kSafetyRescanSamples samples
+// bounds staleness for changes no hook sees.
+class InventoryTracker {
+public:
+	static constexpr int kSizeCount = 5; // sizes 0..4
+	static constexpr uint32_t kSafetyRescanSamples = 30;
+
+	void Invalidate() { m_dirty = true; }
+
+	// Cheap per-pulse check: any item picked up or put down passes through the cursor.
+	void NoteCursor(const void* cursorItem)
+	{
+		if (cursorItem != m_cursorItem) {
+			m_cursorItem = cursorItem;
+			m_dirty = true;
+		}
+	}
+
+	// Rescan the bags if invalidated. Returns true if the totals changed.
+	bool Refresh();
+
+	// Cumulative free slots: index s counts every slot that fits an item of size s.
+	void WriteTo(google::protobuf::RepeatedField<int32_t>* out) const;
+
+	uint64_t Generation() const { return m_generation; }
+
+	void Reset()
+	{
+		m_freeBySize = {};
+		m_dirty = true;
+		m_cursorItem = nullptr;
+		m_samplesSinceRescan = 0;
+		m_generation++;
+	}
+
+private:
+	std::array<int, kSizeCount> m_freeBySize = {};
+	const void* m_cursorItem = nullptr;
+	uint32_t m_samplesSinceRescan = 0;
+	bool m_dirty = true;
+	uint64_t m_generation = 0;
+};
+
+bool InventoryTracker::Refresh()
+{
+	if (++m_samplesSinceRescan >= kSafetyRescanSamples)
+		m_dirty = true;
+	if (!m_dirty)
+		return false;
+
+	PcProfile* profile = GetPcProfile();
+	if (!profile)
+		return false;
+
+	constexpr int slotMax = kSizeCount - 1;
+	const std::array<int, kSizeCount> before = m_freeBySize;
+	m_freeBySize = {};
+	for (int slot = InvSlot_FirstBagSlot; slot <= InvSlot_LastBagSlot && slot <= GetHighestAvailableBagSlot(); slot++) {
+		if (ItemPtr pItem = profile->InventoryContainer.GetItem(slot)) {
+			if (pItem->IsContainer()) {
+				int cap = static_cast<int>(pItem->GetItemDefinition()->SizeCapacity);
+				m_freeBySize[(cap >= 0 && cap <= slotMax) ? cap : slotMax] += pItem->GetHeldItems().GetSize() - pItem->GetHeldItems().GetCount();
+			}
+		} else {
+			m_freeBySize[slotMax]++;
+		}
+	}
+	m_samplesSinceRescan = 0;
+	m_dirty = false;
+
+	if (before == m_freeBySize)
+		return false;
+	m_generation++;
+	return true;
+}
+
+void InventoryTracker::WriteTo(google::protobuf::RepeatedField<int32_t>* out) const
+{
+	int running = 0;
+	int cumulative[kSizeCount] = { 0 };
+	for (int s = kSizeCount - 1; s >= 0; s--) {
+		running += m_freeBySize[s];
+		cumulative[s] = running;
+	}
+	out->Clear();
+	for (int s = 0; s < kSizeCount; s++)
+		out->Add(cumulative[s]);
+}
+
+} // namespace
+
+static InventoryTracker s_inventory;
+
+void InvalidateInventory()
+{
+	s_inventory.Invalidate();
+}
+
+void NoteInventoryCursor()
+{
+	if (PcProfile* profile = GetPcProfile())
+		s_inventory.NoteCursor(profile->InventoryContainer.GetItem(InvSlot_Cursor).get());
+}
+
+// --- Section fingerprints: read only the raw game values each section is built from ---
+
+static Fingerprint IdentityFingerprint()
+{
+	Fingerprint fp;
+	fp.AddString(pLocalPlayer->DisplayedName);
+	fp.AddValue(pLocalPlayer->SpawnID);
+	fp.AddValue(pLocalPlayer->Level);
+	fp.AddValue(pLocalPlayer->GetClass());
+	return fp;
+}
+
+static Fingerprint VitalsFingerprint()
+{
+	Fingerprint fp;
+	fp.AddValue(pLocalPlayer->HPCurrent);
+	fp.AddValue(pLocalPlayer->HPMax);
+	fp.AddValue(pLocalPlayer->ManaCurrent);
+	fp.AddValue(pLocalPlayer->ManaMax);
+	fp.AddValue(pLocalPlayer->EnduranceCurrent);
+	fp.AddValue(pLocalPlayer->EnduranceMax);
+	fp.AddValue(ReadStateBits());
+	fp.AddValue(pLocalPlayer->CastingData.SpellID);
+	fp.AddValue(GetCombatState());
+	return fp;
+}
+
+static Fingerprint TargetFingerprint()
+{
+	Fingerprint fp;
+	if (pTarget && pTarget->SpawnID) {
+		fp.AddValue(pTarget->SpawnID);
+		fp.AddString(pTarget->DisplayedName);
+		fp.AddValue(pTarget->HPCurrent);
+		fp.AddValue(pTarget->HPMax);
+	}
+	return fp;
+}
+
+static Fingerprint ZoneFingerprint()
+{
+	Fingerprint fp;
+	fp.AddValue(pZoneInfo->ZoneID);
+	fp.AddValue(pLocalPC ? pLocalPC->instance : 0);
+	fp.AddValue(pLocalPlayer->X);
+	fp.AddValue(pLocalPlayer->Y);
+	fp.AddValue(pLocalPlayer->Z);
+	fp.AddValue(pLocalPlayer->Heading);
+	return fp;
+}
+
+static Fingerprint BuffsFingerprint()
+{
+	PcProfile* profile = GetPcProfile();
+	Fingerprint fp;
+	for (int i = 0; i < NUM_LONG_BUFFS; i++)
+		fp.AddValue(profile->GetEffect(i).SpellID);
+	for (int i = 0; i < NUM_SHORT_BUFFS; i++)
+		fp.AddValue(profile->GetTempEffect(i).SpellID);
+	fp.AddValue(GetCharMaxBuffSlots());
+	fp.AddValue(GetMySpellCounters(SPA_POISON));
+	fp.AddValue(GetMySpellCounters(SPA_DISEASE));
+	fp.AddValue(GetMySpellCounters(SPA_CURSE));
+	fp.AddValue(GetMySpellCounters(SPA_CORRUPTION));
+	return fp;
+}
+
+static Fingerprint PetFingerprint()
+{
+	Fingerprint fp;
+	fp.AddValue(pLocalPlayer->PetID);
+	if (HasPetWindow()) {
+		for (int i = 0; i < MAX_TOTAL_BUFFS_NPC; i++)
+			fp.AddValue(pPetInfoWnd->GetBuff(i));
+		if (PlayerClient* pet = GetSpawnByID(pLocalPlayer->PetID)) {
+			fp.AddValue(pet->HPCurrent);
+			fp.AddValue(pet->HPMax);
+		}
+	}
+	return fp;
+}
+
+static Fingerprint GemsFingerprint()
+{
+	PcProfile* profile = GetPcProfile();
+	Fingerprint fp;
+	for (int i = 0; i < NUM_SPELL_GEMS; i++)
+		fp.AddValue(profile->GetMemorizedSpell(i));
+	return fp;
+}
+
+static Fingerprint ExperienceFingerprint()
+{
+	Fingerprint fp;
+	if (pLocalPC) {
+		fp.AddValue(pLocalPC->Exp);
+		fp.AddValue(pLocalPC->AAExp);
+	}
 	PcProfile* profile = GetPcProfile();
+	fp.AddValue(profile->AAPoints);
+	fp.AddValue(profile->AAPointsSpent);
+	for (int i = 0; i < 6; i++)
+		fp.AddValue(profile->AAPointsAssigned[i]);
+	return fp;
+}
+
+static Fingerprint MakeCampFingerprint(const MakeCampState& state)
+{
+	Fingerprint fp;
+	fp.AddValue(state.present);
+	fp.AddValue(state.status);
+	fp.AddValue(state.x);
+	fp.AddValue(state.y);
+	fp.AddValue(state.radius);
+	fp.AddValue(state.distance);
+	return fp;
+}
+
+static Fingerprint MacroFingerprint()
+{
+	Fingerprint fp;
+	fp.AddString(gszMacroName);
+	bool paused = false;
+	if (gszMacroName[0]) {
+		if (MQMacroBlockPtr pBlock = GetCurrentMacroBlock())
+			paused = pBlock->Paused;
+	}
+	fp.AddValue(paused);
+	return fp;
+}
+
+// --- Section builders: each one fully rewrites the CharinfoPublish fields it owns ---
+
+static void BuildIdentitySection(mq::proto::charinfo::CharinfoPublish* out)
+{
 	out->set_sender(pLocalPlayer->DisplayedName);
 	out->set_name(pLocalPlayer->DisplayedName);
 	out->set_id(pLocalPlayer->SpawnID);
@@ -366,32 +1197,90 @@ bool BuildPublishPayload(mq::proto::charinfo::CharinfoPublish* out)
 
 	int classId = pLocalPlayer->GetClass();
 	auto* ci = out->mutable_class_info();
+	ci->Clear();
 	ci->set_id(classId);
 	ci->set_name(GetClassDesc(classId));
 	constexpr int numClasses = 17;
 	if (classId >= 0 && classId < numClasses)
 		ci->set_short_name(ClassInfo[classId].ShortName);
 
+	out->set_version(CHARINFO_VERSION);
+}
+
+static void BuildVitalsSection(mq::proto::charinfo::CharinfoPublish* out)
+{
 	out->set_pct_hps(pLocalPlayer->HPMax == 0 ? 0 : static_cast<int>(pLocalPlayer->HPCurrent * 100 / pLocalPlayer->HPMax));
 	out->set_pct_mana(pLocalPlayer->ManaCurrent >= 0 && pLocalPlayer->ManaMax > 0
 		? static_cast<int>(pLocalPlayer->ManaCurrent * 100 / pLocalPlayer->ManaMax) : 0);
 
+	out->set_max_endurance(pLocalPlayer->EnduranceMax >= 0 ? static_cast<int>(pLocalPlayer->EnduranceMax) : 0);
+	out->set_current_hp(pLocalPlayer->HPCurrent);
+	out->set_max_hp(pLocalPlayer->HPMax);
+	out->set_current_mana(pLocalPlayer->ManaCurrent >= 0 ? pLocalPlayer->ManaCurrent : 0);
+	out->set_max_mana(pLocalPlayer->ManaMax > 0 ? pLocalPlayer->ManaMax : 0);
+	out->set_current_endurance(pLocalPlayer->EnduranceCurrent >= 0 ? pLocalPlayer->EnduranceCurrent : 0);
+	if (pLocalPlayer->EnduranceMax > 0)
+		out->set_pct_endurance(static_cast<int32_t>(pLocalPlayer->EnduranceCurrent * 100 / pLocalPlayer->EnduranceMax));
+	else
+		out->set_pct_endurance(0);
+
+	// --- State bits (client converts to State[] string array) ---
+	out->set_state_bits(ReadStateBits());
+
+	// --- Casting spell ---
+	out->set_casting_spell_id(pLocalPlayer->CastingData.SpellID > 0 ? pLocalPlayer->CastingData.SpellID : 0);
+
+	// --- Combat state ---
+	out->set_combat_state(static_cast<int32_t>(GetCombatState()));
+
+	// --- Detrimentals: no_cure, life_drain, mana_drain, endu_drain (0 = not computed here) ---
+	// detr_state_bits / bene_state_bits: 0 = client will show empty BuffState[]
+	out->set_detr_state_bits(0);
+	out->set_bene_state_bits(0);
+}
+
+static void BuildTargetSection(mq::proto::charinfo::CharinfoPublish* out)
+{
 	// Target ID and PctHPs: same as NetBots MakeTARGT (MQ2NetBots.cpp) and MQ2SpawnType PctHPs
-	if (pTarget && pTarget->SpawnID) {
+	// Reuse the target submessage while something is targeted; clear_target() would free it.
+	out->set_target_hp(0);
+	if (!pTarget || !pTarget->SpawnID) {
+		out->clear_target();
+	} else {
 		auto* ti = out->mutable_target();
+		ti->Clear();
 		ti->set_id(pTarget->SpawnID);
 		if (pTarget->DisplayedName[0])
 			ti->set_name(pTarget->DisplayedName);
 		out->set_target_hp(pTarget->HPMax == 0 ? 0 : static_cast<int>(pTarget->HPCurrent * 100 / pTarget->HPMax));
 	}
+}
 
+static void BuildZoneSection(mq::proto::charinfo::CharinfoPublish* out)
+{
 	auto* zi = out->mutable_zone();
+	zi->Clear();
 	zi->set_id(pZoneInfo->ZoneID);
 	if (pZoneInfo->ShortName[0])
 		zi->set_short_name(pZoneInfo->ShortName);
 	if (pZoneInfo->LongName[0])
 		zi->set_name(pZoneInfo->LongName);
 
+	// --- Zone position (x, y, z, heading, instance_id) ---
+	zi->set_instance_id(pLocalPC ? static_cast<int32_t>(pLocalPC->instance) : 0);
+	zi->set_x(pLocalPlayer->X);
+	zi->set_y(pLocalPlayer->Y);
+	zi->set_z(pLocalPlayer->Z);
+	zi->set_heading(pLocalPlayer->Heading);
+}
+
+// Buff spells only; durations are written by RefreshBuffTimers so ticking timers never rebuild spell data.
+static void BuildBuffsSection(mq::proto::charinfo::CharinfoPublish* out)
+{
+	PcProfile* profile = GetPcProfile();
+	out->clear_buff_spells();
+	out->clear_short_buff_spells();
+
 	int detrimentals = 0;
 	int usedSlots = 0;
 
@@ -400,18 +1289,14 @@ bool BuildPublishPayload(mq::proto::charinfo::CharinfoPublish* out)
 		if (spellId <= 0)
 			continue;
 		usedSlots++;
-		int dur = static_cast<int>(GetSpellBuffTimer(spellId));
-		if (dur < 0) dur = -1;
-		AddBuffEntry(out, spellId, dur, true, &detrimentals);
+		AddBuffEntry(out, spellId, true, &detrimentals);
 	}
 
 	for (int i = 0; i < NUM_SHORT_BUFFS; i++) {
 		int spellId = profile->GetTempEffect(i).SpellID;
 		if (spellId <= 0)
 			continue;
-		int dur = static_cast<int>(GetSpellBuffTimer(spellId));
-		if (dur < 0) dur = -1;
-		AddBuffEntry(out, spellId, dur, false, &detrimentals);
+		AddBuffEntry(out, spellId, false, &detrimentals);
 	}
 
 	out->set_free_buff_slots(GetCharMaxBuffSlots() - usedSlots);
@@ -420,273 +1305,599 @@ bool BuildPublishPayload(mq::proto::charinfo::CharinfoPublish* out)
 	out->set_count_disease(static_cast<int>(GetMySpellCounters(SPA_DISEASE)));
 	out->set_count_curse(static_cast<int>(GetMySpellCounters(SPA_CURSE)));
 	out->set_count_corruption(static_cast<int>(GetMySpellCounters(SPA_CORRUPTION)));
+}
+
+static void BuildPetSection(mq::proto::charinfo::CharinfoPublish* out)
+{
+	out->clear_pet_buff_spells();
+	out->set_pet_hp(0);
 
-	if (pLocalPlayer->PetID && pPetInfoWnd) {
+	if (HasPetWindow()) {
 		for (int i = 0; i < MAX_TOTAL_BUFFS_NPC; i++) {
 			int spellId = pPetInfoWnd->GetBuff(i);
 			if (spellId <= 0)
 				continue;
-			int dur = static_cast<int>(pPetInfoWnd->GetBuffTimer(i));
-			if (dur < 0) dur = -1;
-			EQ_Spell* spell = GetSpellByID(spellId);
-			if (spell && spell->ID > 0) {
-				auto* si = out->add_pet_buff_spells();
-				si->set_id(spell->ID);
-				if (spell->Name[0])
-					si->set_name(spell->Name);
-				si->set_category(spell->Category);
-				si->set_level(static_cast<int>(spell->GetSpellLevelNeeded(GetPcProfile()->Class)));
-				out->add_pet_buff_durations(dur);
-			}
+			if (const SpellMeta* meta = GetSpellMeta(spellId))
+				SetSpellInfo(out->add_pet_buff_spells(), *meta);
 		}
 		PlayerClient* pet = GetSpawnByID(pLocalPlayer->PetID);
 		if (pet && pet->HPMax > 0)
 			out->set_pet_hp(static_cast<int>(pet->HPCurrent * 100 / pet->HPMax));
 	}
 
-	if (pLocalPlayer->EnduranceMax >= 0)
-		out->set_max_endurance(static_cast<int>(pLocalPlayer->EnduranceMax));
-
-	// --- New top-level vitals ---
-	out->set_current_hp(pLocalPlayer->HPCurrent);
-	out->set_max_hp(pLocalPlayer->HPMax);
-	out->set_current_mana(pLocalPlayer->ManaCurrent >= 0 ? pLocalPlayer->ManaCurrent : 0);
-	out->set_max_mana(pLocalPlayer->ManaMax > 0 ? pLocalPlayer->ManaMax : 0);
-	out->set_current_endurance(pLocalPlayer->EnduranceCurrent >= 0 ? pLocalPlayer->EnduranceCurrent : 0);
-	if (pLocalPlayer->EnduranceMax > 0)
-		out->set_pct_endurance(static_cast<int32_t>(pLocalPlayer->EnduranceCurrent * 100 / pLocalPlayer->EnduranceMax));
-	else
-		out->set_pct_endurance(0);
-
-	// --- Pet (top-level) ---
 	out->set_pet_id(pLocalPlayer->PetID);
 	// Pet affinity (has Pet AA): would require GetAARankByName; set false here.
-	if (pLocalPlayer->PetID && pPetInfoWnd)
-		out->set_pet_affinity(false);
+	out->set_pet_affinity(false);
+}
 
-	// --- Zone position (x, y, z, heading, instance_id) ---
-	zi->set_instance_id(pLocalPC ? static_cast<int32_t>(pLocalPC->instance) : 0);
-	zi->set_x(pLocalPlayer->X);
-	zi->set_y(pLocalPlayer->Y);
-	zi->set_z(pLocalPlayer->Z);
-	zi->set_heading(pLocalPlayer->Heading);
+static void BuildGemsSection(mq::proto::charinfo::CharinfoPublish* out)
+{
+	PcProfile* prof = GetPcProfile();
+	out->clear_gem();
+	for (int i = 0; i < NUM_SPELL_GEMS; i++) {
+		int spellId = prof->GetMemorizedSpell(i);
+		out->add_gem(spellId > 0 ? spellId : 0);
+	}
+}
 
-	// --- State bits (client converts to State[] string array) ---
-	uint32_t stateBits = 0;
-	switch (pLocalPlayer->StandState) {
-		case STANDSTATE_STAND: stateBits |= StateBits::STAND; break;
-		case STANDSTATE_SIT:   stateBits |= StateBits::SIT;   break;
-		case STANDSTATE_DUCK:  stateBits |= StateBits::DUCK;  break;
-		case STANDSTATE_BIND:  stateBits |= StateBits::BIND;  break;
-		case STANDSTATE_FEIGN: stateBits |= StateBits::FEIGN; break;
-		case STANDSTATE_DEAD:  stateBits |= StateBits::DEAD;  break;
-		default: break;
+static void BuildExperienceSection(mq::proto::charinfo::CharinfoPublish* out)
+{
+	if (!pLocalPC) {
+		out->clear_experience();
+		return;
 	}
-	if (pEverQuestInfo && pEverQuestInfo->bAutoAttack)
-		stateBits |= StateBits::ATTACK;
-	if (pLocalPlayer->Mount)
-		stateBits |= StateBits::MOUNT;
-	if (std::fabs(pLocalPlayer->SpeedRun) > 0.0f)
-		stateBits |= StateBits::MOVING;
-	if (pLocalPlayer->AFK)
-		stateBits |= StateBits::AFK;
-	if (pLocalPlayer->LFG)
-		stateBits |= StateBits::LFG;
-	if (pLocalPlayer->RespawnTimer != 0)
-		stateBits |= StateBits::HOVER;
-	if (pLocalPlayer->PlayerState & 0x20)
-		stateBits |= StateBits::STUN;
-	if (pLocalPlayer->mPlayerPhysicsClient.Levitate == 2)
-		stateBits |= StateBits::LEV;
-	if (pLocalPC && pLocalPC->pGroupInfo)
-		stateBits |= StateBits::GROUP;
-	if (pRaid && pRaid->RaidMemberCount)
-		stateBits |= StateBits::RAID;
-	// Invis / ITU: check HideMode or buff-based (simplified: HideMode)
-	if ((pLocalPlayer->HideMode & 0x01))
-		stateBits |= StateBits::INVIS;
-	out->set_state_bits(stateBits);
+	auto* exp = out->mutable_experience();
+	exp->set_pct_exp(static_cast<float>(pLocalPC->Exp) / EXP_TO_PCT_RATIO);
+	exp->set_pct_aa_exp(static_cast<float>(pLocalPC->AAExp) / EXP_TO_PCT_RATIO);
+	exp->set_pct_group_leader_exp(0.f); // optional: GroupLeadershipExp if available
+	PcProfile* pp = GetPcProfile();
+	exp->set_aa_spent(pp->AAPointsSpent);
+	exp->set_aa_unused(pp->AAPoints);
+	int assigned = 0;
+	for (int i = 0; i < 6; i++) assigned += pp->AAPointsAssigned[i];
+	exp->set_aa_assigned(assigned);
+	exp->set_total_aa(pp->AAPoints + pp->AAPointsSpent);
+}
 
-	// --- Casting spell ---
-	if (pLocalPlayer->CastingData.SpellID > 0)
-		out->set_casting_spell_id(pLocalPlayer->CastingData.SpellID);
+static void BuildMakeCampSection(mq::proto::charinfo::CharinfoPublish* out, const MakeCampState& state)
+{
+	// Only when MQ2MoveUtils loaded
+	if (!state.present) {
+		out->clear_make_camp();
+		return;
+	}
+	auto* mc = out->mutable_make_camp();
+	mc->set_status(state.status);
+	mc->set_x(state.x);
+	mc->set_y(state.y);
+	mc->set_radius(state.radius);
+	mc->set_distance(state.distance);
+}
 
-	// --- Combat state ---
-	out->set_combat_state(static_cast<int32_t>(GetCombatState()));
+static void BuildMacroSection(mq::proto::charinfo::CharinfoPublish* out)
+{
+	auto* macro = out->mutable_macro();
+	int macroState = 0; // MACRO_NONE
+	if (gszMacroName[0]) {
+		macroState = 1; // MACRO_RUNNING
+		if (MQMacroBlockPtr pBlock = GetCurrentMacroBlock()) {
+			if (pBlock->Paused)
+				macroState = 2; // MACRO_PAUSED
+		}
+	}
+	macro->set_macro_state(macroState);
+	macro->set_macro_name(gszMacroName);
+}
+
+static void BuildLuaSection(mq::proto::charinfo::CharinfoPublish* out)
+{
+	s_luaCache.WriteTo(out->mutable_lua());
+}
+
+// Free inventory by size 0..4
+static void BuildInventorySection(mq::proto::charinfo::CharinfoPublish* out)
+{
+	s_inventory.WriteTo(out->mutable_free_inventory());
+}
 
-	// --- Detrimentals: no_cure, life_drain, mana_drain, endu_drain (0 = not computed here) ---
-	// detr_state_bits / bene_state_bits: 0 = client will show empty BuffState[]
-	out->set_detr_state_bits(0);
-	out->set_bene_state_bits(0);
+// Buff timers only advance in whole ticks, so a recomputed expiry wobbles by up to one tick (6s)
+// without the buff having been refreshed; smaller moves keep the previous expiry.
+static constexpr int64_t kExpirySlackMs = 6000;
 
-	// --- Gems (ordered spell IDs) ---
-	PcProfile* prof = GetPcProfile();
-	if (prof) {
-		for (int i = 0; i < NUM_SPELL_GEMS; i++) {
-			int spellId = prof->GetMemorizedSpell(i);
-			if (spellId > 0)
-				out->add_gem(spellId);
-			else
-				out->add_gem(0);
+// Writes the current timer of every buff entry in place (same entry order as the spell lists):
+// durations for pre-1.6 receivers of a full publish, and expiries on the local clock.
+// Returns true if any expiry changed, i.e. a buff was refreshed, replaced, added or removed.
+static bool RefreshBuffTimers(mq::proto::charinfo::CharinfoPublish* out)
+{
+	const int64_t now = ClockMs();
+	bool changed = false;
+	auto write = [&changed, now](google::protobuf::RepeatedField<int32_t>* durations,
+		google::protobuf::RepeatedField<int64_t>* expires, int index, int duration) {
+		const int64_t expiry = duration < 0 ? 0 : now + duration;
+		if (index < durations->size())
+			durations->Set(index, duration);
+		else
+			durations->Add(duration);
+		if (index < expires->size()) {
+			const int64_t previous = expires->Get(index);
+			const bool drift = previous != 0 && expiry != 0 && std::llabs(expiry - previous) <= kExpirySlackMs;
+			if (previous != expiry && !drift) {
+				expires->Set(index, expiry);
+				changed = true;
+			}
+		} else {
+			expires->Add(expiry);
+			changed = true;
 		}
+	};
+	auto truncate = [&changed](google::protobuf::RepeatedField<int32_t>* durations,
+		google::protobuf::RepeatedField<int64_t>* expires, int size) {
+		if (durations->size() > size)
+			durations->Truncate(size);
+		if (expires->size() > size) {
+			expires->Truncate(size);
+			changed = true;
+		}
+	};
+
+	PcProfile* profile = GetPcProfile();
+	int n = 0;
+	for (int i = 0; i < NUM_LONG_BUFFS; i++) {
+		int spellId = profile->GetEffect(i).SpellID;
+		if (spellId > 0 && IsValidBuffSpell(spellId))
+			write(out->mutable_buff_durations(), out->mutable_buff_expires(), n++, ReadBuffTimer(spellId));
 	}
+	truncate(out->mutable_buff_durations(), out->mutable_buff_expires(), n);
 
-	// --- Version ---
-	out->set_version(CHARINFO_VERSION);
+	n = 0;
+	for (int i = 0; i < NUM_SHORT_BUFFS; i++) {
+		int spellId = profile->GetTempEffect(i).SpellID;
+		if (spellId > 0 && IsValidBuffSpell(spellId))
+			write(out->mutable_short_buff_durations(), out->mutable_short_buff_expires(), n++, ReadBuffTimer(spellId));
+	}
+	truncate(out->mutable_short_buff_durations(), out->mutable_short_buff_expires(), n);
 
-	// --- Experience ---
-	if (pLocalPC) {
-		auto* exp = out->mutable_experience();
-		exp->set_pct_exp(static_cast<float>(pLocalPC->Exp) / EXP_TO_PCT_RATIO);
-		exp->set_pct_aa_exp(static_cast<float>(pLocalPC->AAExp) / EXP_TO_PCT_RATIO);
-		exp->set_pct_group_leader_exp(0.f); // optional: GroupLeadershipExp if available
-		PcProfile* pp = GetPcProfile();
-		if (pp) {
-			exp->set_aa_spent(pp->AAPointsSpent);
-			exp->set_aa_unused(pp->AAPoints);
-			int assigned = 0;
-			for (int i = 0; i < 6; i++) assigned += pp->AAPointsAssigned[i];
-			exp->set_aa_assigned(assigned);
-			exp->set_total_aa(pp->AAPoints + pp->AAPointsSpent);
+	n = 0;
+	if (HasPetWindow()) {
+		for (int i = 0; i < MAX_TOTAL_BUFFS_NPC; i++) {
+			int spellId = pPetInfoWnd->GetBuff(i);
+			if (spellId > 0 && IsValidBuffSpell(spellId))
+				write(out->mutable_pet_buff_durations(), out->mutable_pet_buff_expires(), n++, ReadPetBuffTimer(i));
 		}
 	}
+	truncate(out->mutable_pet_buff_durations(), out->mutable_pet_buff_expires(), n);
 
-	// --- MakeCamp (only when MQ2MoveUtils loaded; null guards) ---
-	if (IsPluginLoaded("MQ2MoveUtils")) {
-		char buf[256];
-		strcpy_s(buf, "${Select[${MakeCamp.Status},ON,PAUSED]}:${MakeCamp.AnchorX}:${MakeCamp.AnchorY}:${MakeCamp.CampRadius}:${MakeCamp.CampDist}");
-		if (ParseMacroData(buf, sizeof(buf))) {
-			auto* mc = out->mutable_make_camp();
-			float x = 0, y = 0, r = 0, d = 0;
-			int status = 0;
-			if (sscanf_s(buf, "%d:%f:%f:%f:%f", &status, &x, &y, &r, &d) >= 5) {
-				mc->set_status(status);
-				mc->set_x(x);
-				mc->set_y(y);
-				mc->set_radius(r);
-				mc->set_distance(d);
-			}
-		}
+	return changed;
+}
+
+bool BuildPublishPayload(mq::proto::charinfo::CharinfoPublish* out)
+{
+	if (!pLocalPlayer || !GetPcProfile() || !pZoneInfo)
+		return false;
+
+	BuildIdentitySection(out);
+	BuildVitalsSection(out);
+	BuildTargetSection(out);
+	BuildZoneSection(out);
+	BuildBuffsSection(out);
+	BuildPetSection(out);
+	RefreshBuffTimers(out);
+	BuildGemsSection(out);
+	BuildExperienceSection(out);
+	BuildMakeCampSection(out, ReadMakeCampState());
+	BuildMacroSection(out);
+	s_luaCache.Refresh();
+	BuildLuaSection(out);
+	s_inventory.Refresh();
+	BuildInventorySection(out);
+	return true;
+}
+
+void PublishSampler::Reset()
+{
+	m_valid = 0;
+	s_luaCache.Reset();
+	s_inventory.Reset();
+}
+
+// --- Dead reckoning (2.5+) ---
+
+// Samples further apart than this give no usable velocity; the fix is sent at rest.
+static constexpr int64_t kMaxVelocitySampleMs = 2000;
+// Faster than any run speed: a jump like this is a teleport (gate, summon), not movement.
+static constexpr float kMaxSpeed = 250.0f;
+// Heading turn (client units, 0-512) that forces a fix even when the position is still predicted.
+static constexpr float kHeadingThreshold = 8.0f;
+
+static int32_t QuantizePosition(float value)
+{
+	return static_cast<int32_t>(std::lround(value * kPositionScale));
+}
+
+bool PositionTracker::Update(mq::proto::charinfo::CharinfoPublish* snapshot, int64_t nowMs, float threshold)
+{
+	const auto& zone = snapshot->zone();
+	const bool sameZone = m_hasFix && zone.id() == m_zoneId && zone.instance_id() == m_instanceId;
+
+	float vx = 0, vy = 0, vz = 0;
+	if (sameZone && m_lastMs != 0 && nowMs > m_lastMs && nowMs - m_lastMs <= kMaxVelocitySampleMs) {
+		const float dt = static_cast<float>(nowMs - m_lastMs) / 1000.0f;
+		vx = (zone.x() - m_lastX) / dt;
+		vy = (zone.y() - m_lastY) / dt;
+		vz = (zone.z() - m_lastZ) / dt;
+		if (vx * vx + vy * vy + vz * vz > kMaxSpeed * kMaxSpeed)
+			vx = vy = vz = 0;
+	}
+	m_lastX = zone.x();
+	m_lastY = zone.y();
+	m_lastZ = zone.z();
+	m_lastMs = nowMs;
+
+	bool needed = !sameZone;
+	if (!needed) {
+		// Where receivers currently place us: the same extrapolation as PeerZoneInfo::X/Y/Z.
+		const float elapsed = static_cast<float>(std::clamp<int64_t>(nowMs - m_fix.at_ms(), 0, kMaxExtrapolationMs)) / 1000.0f;
+		const float dX = zone.x() - (m_fix.x() + m_fix.vx() * elapsed) / kPositionScale;
+		const float dY = zone.y() - (m_fix.y() + m_fix.vy() * elapsed) / kPositionScale;
+		const float dZ = zone.z() - (m_fix.z() + m_fix.vz() * elapsed) / kPositionScale;
+		float turn = std::fabs(zone.heading() - static_cast<float>(m_fix.heading()) / kPositionScale);
+		turn = std::min(turn, 512.0f - turn);
+		needed = dX * dX + dY * dY + dZ * dZ > threshold * threshold || turn > kHeadingThreshold;
 	}
 
-	// --- Macro ---
-	{
-		auto* macro = out->mutable_macro();
-		int macroState = 0; // MACRO_NONE
-		if (gszMacroName[0]) {
-			macroState = 1; // MACRO_RUNNING
-			if (MQMacroBlockPtr pBlock = GetCurrentMacroBlock()) {
-				if (pBlock->Paused)
-					macroState = 2; // MACRO_PAUSED
-			}
-		}
-		macro->set_macro_state(macroState);
-		macro->set_macro_name(gszMacroName);
+	if (needed) {
+		m_fix.set_x(QuantizePosition(zone.x()));
+		m_fix.set_y(QuantizePosition(zone.y()));
+		m_fix.set_z(QuantizePosition(zone.z()));
+		m_fix.set_vx(QuantizePosition(vx));
+		m_fix.set_vy(QuantizePosition(vy));
+		m_fix.set_vz(QuantizePosition(vz));
+		m_fix.set_heading(static_cast<uint32_t>(std::max(0, QuantizePosition(zone.heading()))));
+		m_fix.set_at_ms(nowMs);
+		m_hasFix = true;
+		m_zoneId = zone.id();
+		m_instanceId = zone.instance_id();
 	}
+	*snapshot->mutable_position() = m_fix;
+	return needed;
+}
 
-	// --- Lua ---
-	{
-		auto* lua = out->mutable_lua();
-		MQTopLevelObject* luaTlo = FindMQ2Data("Lua");
-		if (luaTlo) {
-			MQTypeVar luaVar;
-			if (luaTlo->Function("", luaVar)) {
-				MQTypeVar pidsVar;
-				std::string pidsText;
-				if (EvalMember(luaVar, "PIDs", nullptr, pidsVar) && TypeVarToString(pidsVar, pidsText) && !pidsText.empty()) {
-					for (const std::string& pidToken : SplitCSV(pidsText)) {
-						const int pid = GetIntFromString(pidToken, 0);
-						if (pid <= 0)
-							continue;
-
-						char pidIndex[32] = { 0 };
-						sprintf_s(pidIndex, "%d", pid);
-
-						MQTypeVar scriptVar;
-						if (!EvalMember(luaVar, "Script", pidIndex, scriptVar))
-							continue;
-
-						MQTypeVar statusVar;
-						std::string status;
-						if (!EvalMember(scriptVar, "Status", nullptr, statusVar) || !TypeVarToString(statusVar, status))
-							continue;
-
-						mq::trim(status);
-						if (status != "RUNNING" && status != "PAUSED")
-							continue;
-
-						auto* script = lua->add_scripts();
-						script->set_pid(pid);
-						script->set_status(status);
-
-						MQTypeVar nameVar;
-						std::string nameText;
-						if (EvalMember(scriptVar, "Name", nullptr, nameVar) && TypeVarToString(nameVar, nameText) && !nameText.empty())
-							script->set_name(nameText);
-
-						MQTypeVar pathVar;
-						std::string pathText;
-						if (EvalMember(scriptVar, "Path", nullptr, pathVar) && TypeVarToString(pathVar, pathText) && !pathText.empty())
-							script->set_path(pathText);
-
-						MQTypeVar argsVar;
-						std::string argsText;
-						if (EvalMember(scriptVar, "Arguments", nullptr, argsVar) && TypeVarToString(argsVar, argsText) && !argsText.empty()) {
-							for (const std::string& arg : SplitCSV(argsText))
-								script->add_arguments(arg);
-						}
-					}
-				}
-			}
+void PositionTracker::Reset()
+{
+	m_fix.Clear();
+	m_hasFix = false;
+	m_zoneId = 0;
+	m_instanceId = 0;
+	m_lastMs = 0;
+}
+
+SessionStrings::Entry& SessionStrings::Intern(const std::string& value)
+{
+	auto it = m_entries.find(value);
+	if (it != m_entries.end())
+		return it->second;
+	if (m_nextToken > kMaxSessionStrings) {
+		// Out of tokens: start over. Reused tokens are always defined again before they are referenced.
+		m_entries.clear();
+		m_nextToken = 1;
+	}
+	Entry& entry = m_entries[value];
+	entry.token = m_nextToken++;
+	return entry;
+}
+
+void SessionStrings::Keyframe(mq::proto::charinfo::CharinfoPublish* publish)
+{
+	Undefine();
+	publish->clear_string_tokens();
+	ForEachPublishString(*publish, [&](const std::string& value) {
+		if (value.empty()) {
+			publish->add_string_tokens(0);
+			return;
+		}
+		Entry& entry = Intern(value);
+		entry.defined = true;
+		publish->add_string_tokens(entry.token);
+	});
+	while (publish->string_tokens_size() > 0 && publish->string_tokens(publish->string_tokens_size() - 1) == 0)
+		publish->mutable_string_tokens()->RemoveLast();
+}
+
+void SessionStrings::Carry(mq::proto::charinfo::CharinfoPublish* publish)
+{
+	std::vector<const std::string*> stillDefined;
+	const uint32_t firstFreeToken = m_nextToken;
+	publish->clear_string_tokens();
+	ForEachPublishString(*publish, [&](const std::string& value) {
+		if (value.empty()) {
+			publish->add_string_tokens(0);
+			return;
 		}
+		Entry& entry = Intern(value);
+		if (entry.defined)
+			stillDefined.push_back(&value);
+		publish->add_string_tokens(entry.token);
+	});
+	while (publish->string_tokens_size() > 0 && publish->string_tokens(publish->string_tokens_size() - 1) == 0)
+		publish->mutable_string_tokens()->RemoveLast();
+	Undefine();
+	// Interning ran out of tokens and started the table over: nothing is defined for anyone.
+	if (m_nextToken < firstFreeToken)
+		return;
+	for (const std::string* value : stillDefined) {
+		auto it = m_entries.find(*value);
+		if (it != m_entries.end())
+			it->second.defined = true;
 	}
+}
 
-	// --- Free inventory (by size 0..4) ---
-	{
-		int freeSlots[5] = { 0 };
-		int slotMax = 4;
-		PcProfile* pp = GetPcProfile();
-		if (pp) {
-			for (int slot = InvSlot_FirstBagSlot; slot <= GetHighestAvailableBagSlot(); slot++) {
-				if (ItemPtr pItem = pp->InventoryContainer.GetItem(slot)) {
-					if (pItem->IsContainer()) {
-						int cap = static_cast<int>(pItem->GetItemDefinition()->SizeCapacity);
-						int iSize = (cap >= 0 && cap <= slotMax) ? cap : slotMax;
-						freeSlots[iSize] += pItem->GetHeldItems().GetSize() - pItem->GetHeldItems().GetCount();
-					}
-				} else {
-					freeSlots[slotMax]++;
-				}
-			}
-			for (int s = slotMax - 1; s >= 0; s--)
-				freeSlots[s] += freeSlots[s + 1];
+void SessionStrings::Tokenize(mq::proto::charinfo::CharinfoUpdate* update)
+{
+	PublishStats& stats = GetPublishStats();
+	update->clear_string_tokens();
+	ForEachUpdateString(update, [&](std::string* value) {
+		if (value->empty()) {
+			update->add_string_tokens(0);
+			return;
+		}
+		Entry& entry = Intern(*value);
+		update->add_string_tokens(entry.token);
+		if (entry.defined) {
+			stats.session_string_refs++;
+			stats.session_string_bytes_saved += value->size();
+			value->clear();
+		} else {
+			entry.defined = true;
+			stats.session_string_definitions++;
 		}
-		for (int i = 0; i < 5; i++)
-			out->add_free_inventory(freeSlots[i]);
+	});
+	while (update->string_tokens_size() > 0 && update->string_tokens(update->string_tokens_size() - 1) == 0)
+		update->mutable_string_tokens()->RemoveLast();
+}
+
+void SessionStrings::Undefine()
+{
+	for (auto& [value, entry] : m_entries)
+		entry.defined = false;
+}
+
+void SessionStrings::Reset()
+{
+	m_entries.clear();
+	m_nextToken = 1;
+}
+
+bool PublishSampler::Sample(mq::proto::charinfo::CharinfoPublish* snapshot, SectionMask* dirty, SectionMask sections)
+{
+	if (dirty)
+		*dirty = 0;
+	if (!pLocalPlayer || !GetPcProfile() || !pZoneInfo)
+		return false;
+
+	SectionMask changed = 0;
+	auto wants = [sections](PublishSection section) { return (sections & SectionBit(section)) != 0; };
+	auto refresh = [&](PublishSection section, const Fingerprint& fp, auto&& build) {
+		const SectionMask bit = SectionBit(section);
+		const size_t index = static_cast<size_t>(section);
+		if ((m_valid & bit) && m_fingerprints[index] == fp.Value())
+			return;
+		build();
+		m_fingerprints[index] = fp.Value();
+		m_valid |= bit;
+		changed |= bit;
+	};
+
+	if (wants(PublishSection::Identity))
+		refresh(PublishSection::Identity, IdentityFingerprint(), [&] { BuildIdentitySection(snapshot); });
+	if (wants(PublishSection::Vitals))
+		refresh(PublishSection::Vitals, VitalsFingerprint(), [&] { BuildVitalsSection(snapshot); });
+	if (wants(PublishSection::Target))
+		refresh(PublishSection::Target, TargetFingerprint(), [&] { BuildTargetSection(snapshot); });
+	if (wants(PublishSection::Zone))
+		refresh(PublishSection::Zone, ZoneFingerprint(), [&] { BuildZoneSection(snapshot); });
+
+	// Timers are written against the current buff lists, so the (cheap) spell ID fingerprints are
+	// always checked first when timers are sampled.
+	if (wants(PublishSection::Buffs) || wants(PublishSection::BuffTimers))
+		refresh(PublishSection::Buffs, BuffsFingerprint(), [&] { BuildBuffsSection(snapshot); });
+	if (wants(PublishSection::Pet) || wants(PublishSection::BuffTimers))
+		refresh(PublishSection::Pet, PetFingerprint(), [&] { BuildPetSection(snapshot); });
+	if (wants(PublishSection::BuffTimers) || (changed & (SectionBit(PublishSection::Buffs) | SectionBit(PublishSection::Pet)))) {
+		if (RefreshBuffTimers(snapshot))
+			changed |= SectionBit(PublishSection::BuffTimers);
+	}
+
+	if (wants(PublishSection::Gems))
+		refresh(PublishSection::Gems, GemsFingerprint(), [&] { BuildGemsSection(snapshot); });
+	if (wants(PublishSection::Experience))
+		refresh(PublishSection::Experience, ExperienceFingerprint(), [&] { BuildExperienceSection(snapshot); });
+	if (wants(PublishSection::MakeCamp)) {
+		const MakeCampState camp = ReadMakeCampState();
+		refresh(PublishSection::MakeCamp, MakeCampFingerprint(camp), [&] { BuildMakeCampSection(snapshot, camp); });
+	}
+	if (wants(PublishSection::Macro))
+		refresh(PublishSection::Macro, MacroFingerprint(), [&] { BuildMacroSection(snapshot); });
+	if (wants(PublishSection::Lua)) {
+		s_luaCache.Refresh();
+		Fingerprint fp;
+		fp.AddValue(s_luaCache.Generation());
+		refresh(PublishSection::Lua, fp, [&] { BuildLuaSection(snapshot); });
+	}
+	if (wants(PublishSection::Inventory)) {
+		s_inventory.Refresh();
+		Fingerprint fp;
+		fp.AddValue(s_inventory.Generation());
+		refresh(PublishSection::Inventory, fp, [&] { BuildInventorySection(snapshot); });
 	}
 
+	if (dirty)
+		*dirty = changed;
 	return true;
 }
 
+void CopySections(const mq::proto::charinfo::CharinfoPublish& from, mq::proto::charinfo::CharinfoPublish* to,
+	SectionMask sections)
+{
+	auto wants = [sections](PublishSection section) { return (sections & SectionBit(section)) != 0; };
+
+	// Assignment into existing fields reuses their strings and repeated elements, so syncing a
+	// snapshot in steady state does not allocate.
+	if (wants(PublishSection::Identity)) {
+		to->set_sender(from.sender());
+		to->set_name(from.name());
+		to->set_id(from.id());
+		to->set_level(from.level());
+		*to->mutable_class_info() = from.class_info();
+		to->set_version(from.version());
+	}
+	if (wants(PublishSection::Vitals)) {
+		to->set_pct_hps(from.pct_hps());
+		to->set_pct_mana(from.pct_mana());
+		to->set_max_endurance(from.max_endurance());
+		to->set_current_hp(from.current_hp());
+		to->set_max_hp(from.max_hp());
+		to->set_current_mana(from.current_mana());
+		to->set_max_mana(from.max_mana());
+		to->set_current_endurance(from.current_endurance());
+		to->set_pct_endurance(from.pct_endurance());
+		to->set_no_cure(from.no_cure());
+		to->set_life_drain(from.life_drain());
+		to->set_mana_drain(from.mana_drain());
+		to->set_endu_drain(from.endu_drain());
+		to->set_state_bits(from.state_bits());
+		to->set_detr_state_bits(from.detr_state_bits());
+		to->set_bene_state_bits(from.bene_state_bits());
+		to->set_casting_spell_id(from.casting_spell_id());
+		to->set_combat_state(from.combat_state());
+	}
+	if (wants(PublishSection::Target)) {
+		if (from.has_target())
+			*to->mutable_target() = from.target();
+		else
+			to->clear_target();
+		to->set_target_hp(from.target_hp());
+	}
+	if (wants(PublishSection::Zone)) {
+		*to->mutable_zone() = from.zone();
+		if (from.has_position())
+			*to->mutable_position() = from.position();
+		else
+			to->clear_position();
+	}
+	if (wants(PublishSection::Buffs)) {
+		*to->mutable_buff_spells() = from.buff_spells();
+		*to->mutable_short_buff_spells() = from.short_buff_spells();
+		to->set_free_buff_slots(from.free_buff_slots());
+		to->set_detrimentals(from.detrimentals());
+		to->set_count_poison(from.count_poison());
+		to->set_count_disease(from.count_disease());
+		to->set_count_curse(from.count_curse());
+		to->set_count_corruption(from.count_corruption());
+	}
+	if (wants(PublishSection::BuffTimers)) {
+		*to->mutable_buff_durations() = from.buff_durations();
+		*to->mutable_short_buff_durations() = from.short_buff_durations();
+		*to->mutable_pet_buff_durations() = from.pet_buff_durations();
+		*to->mutable_buff_expires() = from.buff_expires();
+		*to->mutable_short_buff_expires() = from.short_buff_expires();
+		*to->mutable_pet_buff_expires() = from.pet_buff_expires();
+	}
+	if (wants(PublishSection::Pet)) {
+		*to->mutable_pet_buff_spells() = from.pet_buff_spells();
+		to->set_pet_hp(from.pet_hp());
+		to->set_pet_id(from.pet_id());
+		to->set_pet_affinity(from.pet_affinity());
+	}
+	if (wants(PublishSection::Gems))
+		*to->mutable_gem() = from.gem();
+	if (wants(PublishSection::Experience)) {
+		if (from.has_experience())
+			*to->mutable_experience() = from.experience();
+		else
+			to->clear_experience();
+	}
+	if (wants(PublishSection::MakeCamp)) {
+		if (from.has_make_camp())
+			*to->mutable_make_camp() = from.make_camp();
+		else
+			to->clear_make_camp();
+	}
+	if (wants(PublishSection::Macro))
+		*to->mutable_macro() = from.macro();
+	if (wants(PublishSection::Lua))
+		*to->mutable_lua() = from.lua();
+	if (wants(PublishSection::Inventory))
+		*to->mutable_free_inventory() = from.free_inventory();
+}
+
 namespace {
 
 using FieldId = mq::proto::charinfo::CharinfoFieldId;
 
-static bool SpellInfoEqual(const mq::proto::charinfo::SpellInfo& a, const mq::proto::charinfo::SpellInfo& b) {
-	return a.id() == b.id() && a.name() == b.name() && a.category() == b.category() && a.level() == b.level();
-}
+using SpellList = google::protobuf::RepeatedPtrField<mq::proto::charinfo::SpellInfo>;
+using Int64Field = google::protobuf::RepeatedField<int64_t>;
 
-static bool BuffSpellsEqual(const mq::proto::charinfo::CharinfoPublish& cur, const mq::proto::charinfo::CharinfoPublish& prev,
-	int (mq::proto::charinfo::CharinfoPublish::*size)() const,
-	const mq::proto::charinfo::SpellInfo& (mq::proto::charinfo::CharinfoPublish::*get)(int) const)
+static bool SpellListEqual(const SpellList& a, const SpellList& b)
 {
-	int n = (cur.*size)();
-	if ((prev.*size)() != n) return false;
-	for (int i = 0; i < n; i++)
-		if (!SpellInfoEqual((cur.*get)(i), (prev.*get)(i))) return false;
+	if (a.size() != b.size()) return false;
+	for (int i = 0; i < a.size(); i++)
+		if (!SpellInfoEqual(a.Get(i), b.Get(i))) return false;
 	return true;
 }
 
+static int64_t ExpiryAt(const Int64Field& expires, int index)
+{
+	return index < expires.size() ? expires.Get(index) : 0;
+}
+
+// Common prefix and suffix of two lists; a list delta only edits the differing middle.
+struct ListAlignment {
+	int prefix = 0;
+	int suffix = 0;
+};
+
+template <typename Same>
+static ListAlignment AlignLists(int prevSize, int curSize, Same same)
+{
+	ListAlignment a;
+	const int shorter = std::min(prevSize, curSize);
+	while (a.prefix < shorter && same(a.prefix, a.prefix))
+		a.prefix++;
+	while (a.suffix < shorter - a.prefix && same(prevSize - 1 - a.suffix, curSize - 1 - a.suffix))
+		a.suffix++;
+	return a;
+}
+
+// One op per element of the longer middle; past half the list, resending it whole is smaller.
+static bool ListDeltaWorthwhile(int prevSize, int curSize, const ListAlignment& a)
+{
+	const int ops = std::max(prevSize, curSize) - a.prefix - a.suffix;
+	return ops * 2 <= curSize;
+}
+
+// REPLACE over the differing middle, then INSERT or REMOVE for the length difference.
+// fill(op, curIndex) sets the new element of REPLACE / INSERT ops.
+template <typename Fill>
+static void AddListOps(mq::proto::charinfo::ListDelta* delta, int prevSize, int curSize, const ListAlignment& a, Fill fill)
+{
+	using Kind = mq::proto::charinfo::ListOpKind;
+	const int prevMiddle = prevSize - a.prefix - a.suffix;
+	const int curMiddle = curSize - a.prefix - a.suffix;
+	const int replaced = std::min(prevMiddle, curMiddle);
+	for (int i = 0; i < curMiddle; i++) {
+		auto* op = delta->add_ops();
+		op->set_kind(i < replaced ? Kind::LIST_REPLACE : Kind::LIST_INSERT);
+		op->set_index(a.prefix + i);
+		fill(op, a.prefix + i);
+	}
+	for (int i = replaced; i < prevMiddle; i++) {
+		auto* op = delta->add_ops();
+		op->set_kind(Kind::LIST_REMOVE);
+		op->set_index(a.prefix + replaced);
+	}
+	delta->set_size(curSize);
+}
+
 static bool Int32RepeatedEqual(const mq::proto::charinfo::CharinfoPublish& cur, const mq::proto::charinfo::CharinfoPublish& prev,
 	int (mq::proto::charinfo::CharinfoPublish::*size)() const,
 	int32_t (mq::proto::charinfo::CharinfoPublish::*get)(int) const)
@@ -698,14 +1909,89 @@ static bool Int32RepeatedEqual(const mq::proto::charinfo::CharinfoPublish& cur,
 	return true;
 }
 
+static bool Int64RepeatedEqual(const google::protobuf::RepeatedField<int64_t>& cur,
+	const google::protobuf::RepeatedField<int64_t>& prev)
+{
+	if (cur.size() != prev.size()) return false;
+	for (int i = 0; i < cur.size(); i++)
+		if (cur.Get(i) != prev.Get(i)) return false;
+	return true;
+}
+
 } // namespace
 
 bool BuildUpdatePayload(const mq::proto::charinfo::CharinfoPublish& current,
 	const mq::proto::charinfo::CharinfoPublish& previous,
-	mq::proto::charinfo::CharinfoUpdate* out)
+	mq::proto::charinfo::CharinfoUpdate* out,
+	SectionMask sections,
+	float peerVersion)
 {
 	using Id = mq::proto::charinfo::CharinfoFieldId;
 	bool any = false;
+	auto wants = [sections](PublishSection section) { return (sections & SectionBit(section)) != 0; };
+	const bool listDeltas = peerVersion >= CHARINFO_VERSION_LIST_DELTAS;
+	const bool compactSpells = peerVersion >= CHARINFO_VERSION_COMPACT_SPELLS;
+	const bool positionFixes = peerVersion >= CHARINFO_VERSION_POSITION;
+	const bool buffExpiries = peerVersion >= CHARINFO_VERSION_BUFF_EXPIRES;
+	auto addUpdate = [out, &any](Id id) {
+		auto* u = out->add_updates();
+		u->set_field_id(id);
+		any = true;
+		return u;
+	};
+
+	// A buff list and its expiries (durations are not diffed: they tick every pulse). Unchanged
+	// sections compare equal, so both are always checked.
+	// Full lists: a resent spell list resets the receiver's expiries, so they are resent with it.
+	// Deltas: inserted/replaced spells carry their expiry; kept ones get expiry-only REPLACE ops.
+	auto diffBuffList = [&](Id spellsId, Id expiresId, const SpellList& cur, const SpellList& prev,
+		const Int64Field& curExpires, const Int64Field& prevExpires) {
+		const bool spellsChanged = !SpellListEqual(cur, prev);
+		if (!spellsChanged && Int64RepeatedEqual(curExpires, prevExpires))
+			return;
+		if (listDeltas) {
+			const ListAlignment a = AlignLists(prev.size(), cur.size(),
+				[&](int p, int c) { return SpellInfoEqual(prev.Get(p), cur.Get(c)); });
+			if (ListDeltaWorthwhile(prev.size(), cur.size(), a)) {
+				if (spellsChanged) {
+					AddListOps(addUpdate(spellsId)->mutable_list_delta(), prev.size(), cur.size(), a,
+						[&](mq::proto::charinfo::ListOp* op, int c) {
+							*op->mutable_spell() = cur.Get(c);
+							if (!compactSpells)
+								ExpandSpellInfo(op->mutable_spell());
+							op->set_value(ExpiryAt(curExpires, c));
+						});
+				}
+				mq::proto::charinfo::ListDelta* expiries = nullptr;
+				auto keep = [&](int p, int c) {
+					if (ExpiryAt(curExpires, c) == ExpiryAt(prevExpires, p))
+						return;
+					if (!expiries) {
+						expiries = addUpdate(expiresId)->mutable_list_delta();
+						expiries->set_size(cur.size());
+					}
+					auto* op = expiries->add_ops();
+					op->set_kind(mq::proto::charinfo::ListOpKind::LIST_REPLACE);
+					op->set_index(c);
+					op->set_value(ExpiryAt(curExpires, c));
+				};
+				for (int i = 0; i < a.prefix; i++)
+					keep(i, i);
+				for (int i = 0; i < a.suffix; i++)
+					keep(prev.size() - 1 - i, cur.size() - 1 - i);
+				return;
+			}
+		}
+		if (spellsChanged) {
+			auto* list = addUpdate(spellsId)->mutable_spell_list()->mutable_spell();
+			*list = cur;
+			if (!compactSpells) {
+				for (auto& si : *list)
+					ExpandSpellInfo(&si);
+			}
+		}
+		*addUpdate(expiresId)->mutable_int64_list()->mutable_value() = curExpires;
+	};
 
 #define ADD_SCALAR_I32(field, id) do { if (current.field() != previous.field()) { auto* u = out->add_updates(); u->set_field_id(id); u->set_i32(current.field()); any = true; } } while(0)
 #define ADD_SCALAR_I64(field, id) do { if (current.field() != previous.field()) { auto* u = out->add_updates(); u->set_field_id(id); u->set_i64(current.field()); any = true; } } while(0)
@@ -714,104 +2000,150 @@ bool BuildUpdatePayload(const mq::proto::charinfo::CharinfoPublish& current,
 #define ADD_SCALAR_BITS(field, id) do { if (current.field() != previous.field()) { auto* u = out->add_updates(); u->set_field_id(id); u->set_bits(current.field()); any = true; } } while(0)
 #define ADD_SCALAR_B(field, id) do { if (current.field() != previous.field()) { auto* u = out->add_updates(); u->set_field_id(id); u->set_b(current.field()); any = true; } } while(0)
 
-	ADD_SCALAR_STR(sender, Id::FIELD_sender);
-	ADD_SCALAR_STR(name, Id::FIELD_name);
-	ADD_SCALAR_I32(id, Id::FIELD_id);
-	ADD_SCALAR_I32(level, Id::FIELD_level);
-	if (!current.class_info().SerializeAsString().empty() || !previous.class_info().SerializeAsString().empty()) {
-		if (current.class_info().SerializeAsString() != previous.class_info().SerializeAsString()) {
+	if (wants(PublishSection::Identity)) {
+		ADD_SCALAR_STR(sender, Id::FIELD_sender);
+		ADD_SCALAR_STR(name, Id::FIELD_name);
+		ADD_SCALAR_I32(id, Id::FIELD_id);
+		ADD_SCALAR_I32(level, Id::FIELD_level);
+		if (!ClassInfoEqual(current.class_info(), previous.class_info())) {
 			auto* u = out->add_updates(); u->set_field_id(Id::FIELD_class_info); *u->mutable_class_info() = current.class_info(); any = true;
 		}
+		ADD_SCALAR_F(version, Id::FIELD_version);
+	}
+	if (wants(PublishSection::Vitals)) {
+		ADD_SCALAR_I32(pct_hps, Id::FIELD_pct_hps);
+		ADD_SCALAR_I32(pct_mana, Id::FIELD_pct_mana);
+		ADD_SCALAR_I32(max_endurance, Id::FIELD_max_endurance);
+		ADD_SCALAR_I64(current_hp, Id::FIELD_current_hp);
+		ADD_SCALAR_I64(max_hp, Id::FIELD_max_hp);
+		ADD_SCALAR_I32(current_mana, Id::FIELD_current_mana);
+		ADD_SCALAR_I32(max_mana, Id::FIELD_max_mana);
+		ADD_SCALAR_I32(current_endurance, Id::FIELD_current_endurance);
+		ADD_SCALAR_I32(pct_endurance, Id::FIELD_pct_endurance);
+		ADD_SCALAR_I64(no_cure, Id::FIELD_no_cure);
+		ADD_SCALAR_I64(life_drain, Id::FIELD_life_drain);
+		ADD_SCALAR_I64(mana_drain, Id::FIELD_mana_drain);
+		ADD_SCALAR_I64(endu_drain, Id::FIELD_endu_drain);
+		ADD_SCALAR_BITS(state_bits, Id::FIELD_state_bits);
+		ADD_SCALAR_BITS(detr_state_bits, Id::FIELD_detr_state_bits);
+		ADD_SCALAR_BITS(bene_state_bits, Id::FIELD_bene_state_bits);
+		ADD_SCALAR_I32(casting_spell_id, Id::FIELD_casting_spell_id);
+		ADD_SCALAR_I32(combat_state, Id::FIELD_combat_state);
+	}
+	if (wants(PublishSection::Target)) {
+		if (!TargetInfoEqual(current.target(), previous.target())) {
+			auto* u = out->add_updates(); u->set_field_id(Id::FIELD_target); *u->mutable_target() = current.target(); any = true;
+		}
+		ADD_SCALAR_I32(target_hp, Id::FIELD_target_hp);
+	}
+	if (wants(PublishSection::Zone)) {
+		const bool zoneChanged = positionFixes
+			? !ZoneIdentityEqual(current.zone(), previous.zone())
+			: !ZoneInfoEqual(current.zone(), previous.zone());
+		if (zoneChanged) {
+			auto* u = out->add_updates(); u->set_field_id(Id::FIELD_zone); *u->mutable_zone() = current.zone(); any = true;
+		}
+		if (positionFixes && current.has_position() && !PositionInfoEqual(current.position(), previous.position())) {
+			auto* u = out->add_updates(); u->set_field_id(Id::FIELD_position); *u->mutable_position() = current.position(); any = true;
+		}
+	}
+	const bool timers = wants(PublishSection::BuffTimers);
+	if (wants(PublishSection::Buffs) || timers) {
+		diffBuffList(Id::FIELD_buff_spells, Id::FIELD_buff_expires, current.buff_spells(), previous.buff_spells(),
+			current.buff_expires(), previous.buff_expires());
+		diffBuffList(Id::FIELD_short_buff_spells, Id::FIELD_short_buff_expires, current.short_buff_spells(), previous.short_buff_spells(),
+			current.short_buff_expires(), previous.short_buff_expires());
+	}
+	if (wants(PublishSection::Buffs)) {
+		ADD_SCALAR_I32(free_buff_slots, Id::FIELD_free_buff_slots);
+		ADD_SCALAR_I32(detrimentals, Id::FIELD_detrimentals);
+		ADD_SCALAR_I32(count_poison, Id::FIELD_count_poison);
+		ADD_SCALAR_I32(count_disease, Id::FIELD_count_disease);
+		ADD_SCALAR_I32(count_curse, Id::FIELD_count_curse);
+		ADD_SCALAR_I32(count_corruption, Id::FIELD_count_corruption);
+	}
+	if (wants(PublishSection::Pet) || timers) {
+		diffBuffList(Id::FIELD_pet_buff_spells, Id::FIELD_pet_buff_expires, current.pet_buff_spells(), previous.pet_buff_spells(),
+			current.pet_buff_expires(), previous.pet_buff_expires());
+	}
+	if (wants(PublishSection::Pet)) {
+		ADD_SCALAR_I32(pet_hp, Id::FIELD_pet_hp);
+		ADD_SCALAR_I32(pet_id, Id::FIELD_pet_id);
+		ADD_SCALAR_B(pet_affinity, Id::FIELD_pet_affinity);
+	}
+	// Receivers older than 1.6 ignore expiries and keep their timers from duration lists, which
+	// change every pulse while any buff is ticking.
+	if (timers && !buffExpiries) {
+		auto addDurations = [&](Id id, int (mq::proto::charinfo::CharinfoPublish::*size)() const,
+			int32_t (mq::proto::charinfo::CharinfoPublish::*get)(int) const) {
+			if (Int32RepeatedEqual(current, previous, size, get)) return;
+			auto* list = addUpdate(id)->mutable_int32_list();
+			for (int i = 0; i < (current.*size)(); i++) list->add_value((current.*get)(i));
+		};
+		addDurations(Id::FIELD_buff_durations, &mq::proto::charinfo::CharinfoPublish::buff_durations_size,
+			&mq::proto::charinfo::CharinfoPublish::buff_durations);
+		addDurations(Id::FIELD_short_buff_durations, &mq::proto::charinfo::CharinfoPublish::short_buff_durations_size,
+			&mq::proto::charinfo::CharinfoPublish::short_buff_durations);
+		addDurations(Id::FIELD_pet_buff_durations, &mq::proto::charinfo::CharinfoPublish::pet_buff_durations_size,
+			&mq::proto::charinfo::CharinfoPublish::pet_buff_durations);
+	}
+	if (wants(PublishSection::Gems)) {
+		if (!Int32RepeatedEqual(current, previous, &mq::proto::charinfo::CharinfoPublish::gem_size, &mq::proto::charinfo::CharinfoPublish::gem)) {
+			const ListAlignment a = AlignLists(previous.gem_size(), current.gem_size(),
+				[&](int p, int c) { return previous.gem(p) == current.gem(c); });
+			if (listDeltas && ListDeltaWorthwhile(previous.gem_size(), current.gem_size(), a)) {
+				AddListOps(addUpdate(Id::FIELD_gem)->mutable_list_delta(), previous.gem_size(), current.gem_size(), a,
+					[&](mq::proto::charinfo::ListOp* op, int c) { op->set_value(current.gem(c)); });
+			} else {
+				auto* u = out->add_updates(); u->set_field_id(Id::FIELD_gem);
+				auto* list = u->mutable_int32_list(); for (int i = 0; i < current.gem_size(); i++) list->add_value(current.gem(i)); any = true;
+			}
+		}
 	}
-	ADD_SCALAR_I32(pct_hps, Id::FIELD_pct_hps);
-	ADD_SCALAR_I32(pct_mana, Id::FIELD_pct_mana);
-	if (current.target().SerializeAsString() != previous.target().SerializeAsString()) {
-		auto* u = out->add_updates(); u->set_field_id(Id::FIELD_target); *u->mutable_target() = current.target(); any = true;
-	}
-	ADD_SCALAR_I32(target_hp, Id::FIELD_target_hp);
-	if (current.zone().SerializeAsString() != previous.zone().SerializeAsString()) {
-		auto* u = out->add_updates(); u->set_field_id(Id::FIELD_zone); *u->mutable_zone() = current.zone(); any = true;
-	}
-	if (current.buff_spells_size() != previous.buff_spells_size() ||
-	    !BuffSpellsEqual(current, previous, &mq::proto::charinfo::CharinfoPublish::buff_spells_size, &mq::proto::charinfo::CharinfoPublish::buff_spells)) {
-		auto* u = out->add_updates(); u->set_field_id(Id::FIELD_buff_spells);
-		auto* list = u->mutable_spell_list(); for (int i = 0; i < current.buff_spells_size(); i++) *list->add_spell() = current.buff_spells(i); any = true;
-	}
-	if (!Int32RepeatedEqual(current, previous, &mq::proto::charinfo::CharinfoPublish::buff_durations_size, &mq::proto::charinfo::CharinfoPublish::buff_durations)) {
-		auto* u = out->add_updates(); u->set_field_id(Id::FIELD_buff_durations);
-		auto* list = u->mutable_int32_list(); for (int i = 0; i < current.buff_durations_size(); i++) list->add_value(current.buff_durations(i)); any = true;
-	}
-	if (current.short_buff_spells_size() != previous.short_buff_spells_size() ||
-	    !BuffSpellsEqual(current, previous, &mq::proto::charinfo::CharinfoPublish::short_buff_spells_size, &mq::proto::charinfo::CharinfoPublish::short_buff_spells)) {
-		auto* u = out->add_updates(); u->set_field_id(Id::FIELD_short_buff_spells);
-		auto* list = u->mutable_spell_list(); for (int i = 0; i < current.short_buff_spells_size(); i++) *list->add_spell() = current.short_buff_spells(i); any = true;
-	}
-	if (!Int32RepeatedEqual(current, previous, &mq::proto::charinfo::CharinfoPublish::short_buff_durations_size, &mq::proto::charinfo::CharinfoPublish::short_buff_durations)) {
-		auto* u = out->add_updates(); u->set_field_id(Id::FIELD_short_buff_durations);
-		auto* list = u->mutable_int32_list(); for (int i = 0; i < current.short_buff_durations_size(); i++) list->add_value(current.short_buff_durations(i)); any = true;
-	}
-	if (current.pet_buff_spells_size() != previous.pet_buff_spells_size() ||
-	    !BuffSpellsEqual(current, previous, &mq::proto::charinfo::CharinfoPublish::pet_buff_spells_size, &mq::proto::charinfo::CharinfoPublish::pet_buff_spells)) {
-		auto* u = out->add_updates(); u->set_field_id(Id::FIELD_pet_buff_spells);
-		auto* list = u->mutable_spell_list(); for (int i = 0; i < current.pet_buff_spells_size(); i++) *list->add_spell() = current.pet_buff_spells(i); any = true;
-	}
-	if (!Int32RepeatedEqual(current, previous, &mq::proto::charinfo::CharinfoPublish::pet_buff_durations_size, &mq::proto::charinfo::CharinfoPublish::pet_buff_durations)) {
-		auto* u = out->add_updates(); u->set_field_id(Id::FIELD_pet_buff_durations);
-		auto* list = u->mutable_int32_list(); for (int i = 0; i < current.pet_buff_durations_size(); i++) list->add_value(current.pet_buff_durations(i)); any = true;
-	}
-	ADD_SCALAR_I32(free_buff_slots, Id::FIELD_free_buff_slots);
-	ADD_SCALAR_I32(detrimentals, Id::FIELD_detrimentals);
-	ADD_SCALAR_I32(count_poison, Id::FIELD_count_poison);
-	ADD_SCALAR_I32(count_disease, Id::FIELD_count_disease);
-	ADD_SCALAR_I32(count_curse, Id::FIELD_count_curse);
-	ADD_SCALAR_I32(count_corruption, Id::FIELD_count_corruption);
-	ADD_SCALAR_I32(pet_hp, Id::FIELD_pet_hp);
-	ADD_SCALAR_I32(max_endurance, Id::FIELD_max_endurance);
-	ADD_SCALAR_I64(current_hp, Id::FIELD_current_hp);
-	ADD_SCALAR_I64(max_hp, Id::FIELD_max_hp);
-	ADD_SCALAR_I32(current_mana, Id::FIELD_current_mana);
-	ADD_SCALAR_I32(max_mana, Id::FIELD_max_mana);
-	ADD_SCALAR_I32(current_endurance, Id::FIELD_current_endurance);
-	ADD_SCALAR_I32(pct_endurance, Id::FIELD_pct_endurance);
-	ADD_SCALAR_I32(pet_id, Id::FIELD_pet_id);
-	ADD_SCALAR_B(pet_affinity, Id::FIELD_pet_affinity);
-	ADD_SCALAR_I64(no_cure, Id::FIELD_no_cure);
-	ADD_SCALAR_I64(life_drain, Id::FIELD_life_drain);
-	ADD_SCALAR_I64(mana_drain, Id::FIELD_mana_drain);
-	ADD_SCALAR_I64(endu_drain, Id::FIELD_endu_drain);
-	ADD_SCALAR_BITS(state_bits, Id::FIELD_state_bits);
-	ADD_SCALAR_BITS(detr_state_bits, Id::FIELD_detr_state_bits);
-	ADD_SCALAR_BITS(bene_state_bits, Id::FIELD_bene_state_bits);
-	ADD_SCALAR_I32(casting_spell_id, Id::FIELD_casting_spell_id);
-	ADD_SCALAR_I32(combat_state, Id::FIELD_combat_state);
-	if (!Int32RepeatedEqual(current, previous, &mq::proto::charinfo::CharinfoPublish::gem_size, &mq::proto::charinfo::CharinfoPublish::gem)) {
-		auto* u = out->add_updates(); u->set_field_id(Id::FIELD_gem);
-		auto* list = u->mutable_int32_list(); for (int i = 0; i < current.gem_size(); i++) list->add_value(current.gem(i)); any = true;
-	}
-	ADD_SCALAR_F(version, Id::FIELD_version);
-	if (current.has_experience() || previous.has_experience()) {
-		if (current.experience().SerializeAsString() != previous.experience().SerializeAsString()) {
+	if (wants(PublishSection::Experience) && (current.has_experience() || previous.has_experience())) {
+		if (!ExperienceInfoEqual(current.experience(), previous.experience())) {
 			auto* u = out->add_updates(); u->set_field_id(Id::FIELD_experience); *u->mutable_experience() = current.experience(); any = true;
 		}
 	}
-	if (current.has_make_camp() || previous.has_make_camp()) {
-		if (current.make_camp().SerializeAsString() != previous.make_camp().SerializeAsString()) {
+	if (wants(PublishSection::MakeCamp) && (current.has_make_camp() || previous.has_make_camp())) {
+		if (!MakeCampInfoEqual(current.make_camp(), previous.make_camp())) {
 			auto* u = out->add_updates(); u->set_field_id(Id::FIELD_make_camp); *u->mutable_make_camp() = current.make_camp(); any = true;
 		}
 	}
-	if (current.has_macro() || previous.has_macro()) {
-		if (current.macro().SerializeAsString() != previous.macro().SerializeAsString()) {
+	if (wants(PublishSection::Macro) && (current.has_macro() || previous.has_macro())) {
+		if (!MacroInfoEqual(current.macro(), previous.macro())) {
 			auto* u = out->add_updates(); u->set_field_id(Id::FIELD_macro); *u->mutable_macro() = current.macro(); any = true;
 		}
 	}
-	if (current.has_lua() || previous.has_lua()) {
-		if (current.lua().SerializeAsString() != previous.lua().SerializeAsString()) {
-			auto* u = out->add_updates(); u->set_field_id(Id::FIELD_lua); *u->mutable_lua() = current.lua(); any = true;
+	if (wants(PublishSection::Lua) && (current.has_lua() || previous.has_lua())) {
+		if (!LuaInfoEqual(current.lua(), previous.lua())) {
+			if (listDeltas && current.has_lua() && previous.has_lua()) {
+				// Script lists are short; pair them up by PID.
+				auto findPid = [](const mq::proto::charinfo::LuaInfo& lua, int32_t pid) -> const mq::proto::charinfo::LuaScriptInfo* {
+					for (const auto& script : lua.scripts())
+						if (script.pid() == pid) return &script;
+					return nullptr;
+				};
+				auto* delta = addUpdate(Id::FIELD_lua)->mutable_lua_delta();
+				for (const auto& script : current.lua().scripts()) {
+					const auto* before = findPid(previous.lua(), script.pid());
+					if (!before || !LuaScriptInfoEqual(script, *before))
+						*delta->add_upsert() = script;
+				}
+				for (const auto& script : previous.lua().scripts()) {
+					if (!findPid(current.lua(), script.pid()))
+						delta->add_remove_pid(script.pid());
+				}
+			} else {
+				auto* u = out->add_updates(); u->set_field_id(Id::FIELD_lua); *u->mutable_lua() = current.lua(); any = true;
+			}
 		}
 	}
-	if (!Int32RepeatedEqual(current, previous, &mq::proto::charinfo::CharinfoPublish::free_inventory_size, &mq::proto::charinfo::CharinfoPublish::free_inventory)) {
-		auto* u = out->add_updates(); u->set_field_id(Id::FIELD_free_inventory);
-		auto* list = u->mutable_int32_list(); for (int i = 0; i < current.free_inventory_size(); i++) list->add_value(current.free_inventory(i)); any = true;
+	if (wants(PublishSection::Inventory)) {
+		if (!Int32RepeatedEqual(current, previous, &mq::proto::charinfo::CharinfoPublish::free_inventory_size, &mq::proto::charinfo::CharinfoPublish::free_inventory)) {
+			auto* u = out->add_updates(); u->set_field_id(Id::FIELD_free_inventory);
+			auto* list = u->mutable_int32_list(); for (int i = 0; i < current.free_inventory_size(); i++) list->add_value(current.free_inventory(i)); any = true;
+		}
 	}
 
 #undef ADD_SCALAR_I32
@@ -824,6 +2156,157 @@ bool BuildUpdatePayload(const mq::proto::charinfo::CharinfoPublish& current,
 	return any;
 }
 
+namespace {
+
+// In-place list edits on repeated fields: the element is appended (or moved to the end) and
+// swapped into place, so existing elements are reused rather than reallocated.
+template <typename Field>
+static void MoveLastTo(Field* field, int index)
+{
+	for (int k = field->size() - 1; k > index; k--)
+		field->SwapElements(k, k - 1);
+}
+
+template <typename Field>
+static void RemoveAt(Field* field, int index)
+{
+	for (int k = index; k < field->size() - 1; k++)
+		field->SwapElements(k, k + 1);
+	field->RemoveLast();
+}
+
+static bool ValidOpIndex(const mq::proto::charinfo::ListOp& op, int size)
+{
+	const int limit = op.kind() == mq::proto::charinfo::ListOpKind::LIST_INSERT ? size : size - 1;
+	return op.index() >= 0 && op.index() <= limit;
+}
+
+// Buff spell list delta; the parallel duration/expiry lists are kept aligned with the spells.
+static bool ApplySpellListDelta(const mq::proto::charinfo::ListDelta& delta, SpellList* spells,
+	Int64Field* expires, google::protobuf::RepeatedField<int32_t>* durations)
+{
+	using Kind = mq::proto::charinfo::ListOpKind;
+	expires->Resize(spells->size(), 0);
+	durations->Resize(spells->size(), -1);
+	for (const auto& op : delta.ops()) {
+		if (!ValidOpIndex(op, spells->size()))
+			return false;
+		const int index = op.index();
+		switch (op.kind()) {
+		case Kind::LIST_REPLACE:
+			*spells->Mutable(index) = op.spell();
+			expires->Set(index, op.value());
+			durations->Set(index, -1);
+			break;
+		case Kind::LIST_INSERT:
+			*spells->Add() = op.spell();
+			MoveLastTo(spells, index);
+			expires->Add(op.value());
+			MoveLastTo(expires, index);
+			durations->Add(-1);
+			MoveLastTo(durations, index);
+			break;
+		case Kind::LIST_REMOVE:
+			RemoveAt(spells, index);
+			RemoveAt(expires, index);
+			RemoveAt(durations, index);
+			break;
+		default: return false;
+		}
+	}
+	return spells->size() == delta.size();
+}
+
+// Delta of a scalar list (gems, expiries).
+template <typename T>
+static bool ApplyValueListDelta(const mq::proto::charinfo::ListDelta& delta, google::protobuf::RepeatedField<T>* values)
+{
+	using Kind = mq::proto::charinfo::ListOpKind;
+	for (const auto& op : delta.ops()) {
+		if (!ValidOpIndex(op, values->size()))
+			return false;
+		const T value = static_cast<T>(op.value());
+		switch (op.kind()) {
+		case Kind::LIST_REPLACE: values->Set(op.index(), value); break;
+		case Kind::LIST_INSERT: values->Add(value); MoveLastTo(values, op.index()); break;
+		case Kind::LIST_REMOVE: RemoveAt(values, op.index()); break;
+		default: return false;
+		}
+	}
+	return values->size() == delta.size();
+}
+
+static bool ApplyLuaDelta(const mq::proto::charinfo::LuaInfoDelta& delta, mq::proto::charinfo::LuaInfo* lua)
+{
+	auto* scripts = lua->mutable_scripts();
+	for (const auto& script : delta.upsert()) {
+		auto it = std::find_if(scripts->begin(), scripts->end(),
+			[&](const mq::proto::charinfo::LuaScriptInfo& s) { return s.pid() == script.pid(); });
+		if (it != scripts->end())
+			*it = script;
+		else
+			*scripts->Add() = script;
+	}
+	for (int32_t pid : delta.remove_pid()) {
+		for (int i = 0; i < scripts->size(); i++) {
+			if (scripts->Get(i).pid() == pid) {
+				RemoveAt(scripts, i);
+				break;
+			}
+		}
+	}
+	return true;
+}
+
+// Peer-side list delta; make(op) builds the element for REPLACE / INSERT.
+template <typename T, typename Make>
+static bool ApplyListOps(const mq::proto::charinfo::ListDelta& delta, std::vector<T>& list, Make make)
+{
+	using Kind = mq::proto::charinfo::ListOpKind;
+	for (const auto& op : delta.ops()) {
+		if (!ValidOpIndex(op, static_cast<int>(list.size())))
+			return false;
+		const size_t index = static_cast<size_t>(op.index());
+		switch (op.kind()) {
+		case Kind::LIST_REPLACE: list[index] = make(op); break;
+		case Kind::LIST_INSERT: list.insert(list.begin() + index, make(op)); break;
+		case Kind::LIST_REMOVE: list.erase(list.begin() + index); break;
+		default: return false;
+		}
+	}
+	return static_cast<int>(list.size()) == delta.size();
+}
+
+// Expiry deltas are REPLACE-only: the list layout always follows the spell list.
+static bool ApplyExpiryDelta(const mq::proto::charinfo::ListDelta& delta, std::vector<PeerBuffEntry>& entries, int64_t clockOffset)
+{
+	for (const auto& op : delta.ops()) {
+		if (op.kind() != mq::proto::charinfo::ListOpKind::LIST_REPLACE || !ValidOpIndex(op, static_cast<int>(entries.size())))
+			return false;
+		entries[static_cast<size_t>(op.index())].expires_at = ToLocalExpiry(op.value(), clockOffset);
+	}
+	return static_cast<int>(entries.size()) == delta.size();
+}
+
+static bool ApplyPeerLuaDelta(const mq::proto::charinfo::LuaInfoDelta& delta, PeerLuaInfo& lua)
+{
+	for (const auto& script : delta.upsert()) {
+		auto it = std::find_if(lua.scripts.begin(), lua.scripts.end(),
+			[&](const PeerLuaScriptInfo& s) { return s.pid == script.pid(); });
+		if (it != lua.scripts.end())
+			*it = ToPeerLuaScript(script);
+		else
+			lua.scripts.push_back(ToPeerLuaScript(script));
+	}
+	for (int32_t pid : delta.remove_pid()) {
+		lua.scripts.erase(std::remove_if(lua.scripts.begin(), lua.scripts.end(),
+			[pid](const PeerLuaScriptInfo& s) { return s.pid == pid; }), lua.scripts.end());
+	}
+	return true;
+}
+
+} // namespace
+
 bool ApplyFieldUpdate(const mq::proto::charinfo::FieldUpdate& update,
 	mq::proto::charinfo::CharinfoPublish* peer)
 {
@@ -839,11 +2322,15 @@ bool ApplyFieldUpdate(const mq::proto::charinfo::FieldUpdate& update,
 	case Id::FIELD_target: if (update.has_target()) *peer->mutable_target() = update.target(); break;
 	case Id::FIELD_target_hp: if (update.has_i32()) peer->set_target_hp(update.i32()); break;
 	case Id::FIELD_zone: if (update.has_zone()) *peer->mutable_zone() = update.zone(); break;
+	case Id::FIELD_position: if (update.has_position()) *peer->mutable_position() = update.position(); break;
 	case Id::FIELD_buff_spells:
 		if (update.has_spell_list()) {
 			peer->clear_buff_spells();
 			for (int i = 0; i < update.spell_list().spell_size(); i++)
 				*peer->add_buff_spells() = update.spell_list().spell(i);
+		} else if (update.has_list_delta()) {
+			return ApplySpellListDelta(update.list_delta(), peer->mutable_buff_spells(),
+				peer->mutable_buff_expires(), peer->mutable_buff_durations());
 		}
 		break;
 	case Id::FIELD_buff_durations:
@@ -858,6 +2345,9 @@ bool ApplyFieldUpdate(const mq::proto::charinfo::FieldUpdate& update,
 			peer->clear_short_buff_spells();
 			for (int i = 0; i < update.spell_list().spell_size(); i++)
 				*peer->add_short_buff_spells() = update.spell_list().spell(i);
+		} else if (update.has_list_delta()) {
+			return ApplySpellListDelta(update.list_delta(), peer->mutable_short_buff_spells(),
+				peer->mutable_short_buff_expires(), peer->mutable_short_buff_durations());
 		}
 		break;
 	case Id::FIELD_short_buff_durations:
@@ -872,6 +2362,9 @@ bool ApplyFieldUpdate(const mq::proto::charinfo::FieldUpdate& update,
 			peer->clear_pet_buff_spells();
 			for (int i = 0; i < update.spell_list().spell_size(); i++)
 				*peer->add_pet_buff_spells() = update.spell_list().spell(i);
+		} else if (update.has_list_delta()) {
+			return ApplySpellListDelta(update.list_delta(), peer->mutable_pet_buff_spells(),
+				peer->mutable_pet_buff_expires(), peer->mutable_pet_buff_durations());
 		}
 		break;
 	case Id::FIELD_pet_buff_durations:
@@ -881,6 +2374,24 @@ bool ApplyFieldUpdate(const mq::proto::charinfo::FieldUpdate& update,
 				peer->add_pet_buff_durations(update.int32_list().value(i));
 		}
 		break;
+	case Id::FIELD_buff_expires:
+		if (update.has_int64_list())
+			*peer->mutable_buff_expires() = update.int64_list().value();
+		else if (update.has_list_delta())
+			return ApplyValueListDelta(update.list_delta(), peer->mutable_buff_expires());
+		break;
+	case Id::FIELD_short_buff_expires:
+		if (update.has_int64_list())
+			*peer->mutable_short_buff_expires() = update.int64_list().value();
+		else if (update.has_list_delta())
+			return ApplyValueListDelta(update.list_delta(), peer->mutable_short_buff_expires());
+		break;
+	case Id::FIELD_pet_buff_expires:
+		if (update.has_int64_list())
+			*peer->mutable_pet_buff_expires() = update.int64_list().value();
+		else if (update.has_list_delta())
+			return ApplyValueListDelta(update.list_delta(), peer->mutable_pet_buff_expires());
+		break;
 	case Id::FIELD_free_buff_slots: if (update.has_i32()) peer->set_free_buff_slots(update.i32()); break;
 	case Id::FIELD_detrimentals: if (update.has_i32()) peer->set_detrimentals(update.i32()); break;
 	case Id::FIELD_count_poison: if (update.has_i32()) peer->set_count_poison(update.i32()); break;
@@ -889,8 +2400,8 @@ bool ApplyFieldUpdate(const mq::proto::charinfo::FieldUpdate& update,
 	case Id::FIELD_count_corruption: if (update.has_i32()) peer->set_count_corruption(update.i32()); break;
 	case Id::FIELD_pet_hp: if (update.has_i32()) peer->set_pet_hp(update.i32()); break;
 	case Id::FIELD_max_endurance: if (update.has_i32()) peer->set_max_endurance(update.i32()); break;
-	case Id::FIELD_current_hp: if (update.has_i32()) peer->set_current_hp(update.i32()); break;
-	case Id::FIELD_max_hp: if (update.has_i32()) peer->set_max_hp(update.i32()); break;
+	case Id::FIELD_current_hp: if (update.has_i64()) peer->set_current_hp(update.i64()); break;
+	case Id::FIELD_max_hp: if (update.has_i64()) peer->set_max_hp(update.i64()); break;
 	case Id::FIELD_current_mana: if (update.has_i32()) peer->set_current_mana(update.i32()); break;
 	case Id::FIELD_max_mana: if (update.has_i32()) peer->set_max_mana(update.i32()); break;
 	case Id::FIELD_current_endurance: if (update.has_i32()) peer->set_current_endurance(update.i32()); break;
@@ -911,13 +2422,20 @@ bool ApplyFieldUpdate(const mq::proto::charinfo::FieldUpdate& update,
 			peer->clear_gem();
 			for (int i = 0; i < update.int32_list().value_size(); i++)
 				peer->add_gem(update.int32_list().value(i));
+		} else if (update.has_list_delta()) {
+			return ApplyValueListDelta(update.list_delta(), peer->mutable_gem());
 		}
 		break;
 	case Id::FIELD_version: if (update.has_f()) peer->set_version(update.f()); break;
 	case Id::FIELD_experience: if (update.has_experience()) *peer->mutable_experience() = update.experience(); break;
 	case Id::FIELD_make_camp: if (update.has_make_camp()) *peer->mutable_make_camp() = update.make_camp(); break;
 	case Id::FIELD_macro: if (update.has_macro()) *peer->mutable_macro() = update.macro(); break;
-	case Id::FIELD_lua: if (update.has_lua()) *peer->mutable_lua() = update.lua(); break;
+	case Id::FIELD_lua:
+		if (update.has_lua())
+			*peer->mutable_lua() = update.lua();
+		else if (update.has_lua_delta())
+			return ApplyLuaDelta(update.lua_delta(), peer->mutable_lua());
+		break;
 	case Id::FIELD_free_inventory:
 		if (update.has_int32_list()) {
 			peer->clear_free_inventory();
@@ -933,6 +2451,8 @@ bool ApplyFieldUpdate(const mq::proto::charinfo::FieldUpdate& update,
 bool ApplyFieldUpdate(const mq::proto::charinfo::FieldUpdate& update, CharinfoPeer* peer)
 {
 	using Id = mq::proto::charinfo::CharinfoFieldId;
+	// A 1.6+ sender also sends durations while an older peer is around; its expiries stay authoritative.
+	const bool expiries = peer->version >= CHARINFO_VERSION_BUFF_EXPIRES;
 	switch (update.field_id()) {
 	case Id::FIELD_sender: if (update.has_str()) peer->name = update.str(); break;
 	case Id::FIELD_name: if (update.has_str()) peer->name = update.str(); break;
@@ -960,35 +2480,37 @@ bool ApplyFieldUpdate(const mq::proto::charinfo::FieldUpdate& update, CharinfoPe
 			peer->zone.short_name = update.zone().short_name();
 			peer->zone.id = update.zone().id();
 			peer->zone.instance_id = update.zone().instance_id();
-			peer->zone.x = update.zone().x();
-			peer->zone.y = update.zone().y();
-			peer->zone.z = update.zone().z();
-			peer->zone.heading = update.zone().heading();
-			peer->zone.distance = -1.0;
-			SetZoneDistanceFromLocal(peer->zone);
+			SetZonePosition(peer->zone, update.zone());
 		}
 		break;
+	case Id::FIELD_position:
+		if (update.has_position())
+			ApplyPositionFix(peer->zone, update.position(), peer->clock_offset);
+		break;
 	case Id::FIELD_buff_spells:
 		if (update.has_spell_list()) {
 			peer->buff.clear();
 			const int n = update.spell_list().spell_size();
 			for (int i = 0; i < n; i++) {
-				const auto& sp = update.spell_list().spell(i);
 				PeerBuffEntry e;
-				e.spell.name = sp.name();
-				e.spell.id = sp.id();
-				e.spell.category = sp.category();
-				e.spell.level = sp.level();
+				e.spell = ToPeerSpell(update.spell_list().spell(i), peer->class_info.id);
 				e.duration = -1;
 				peer->buff.push_back(std::move(e));
 			}
+		} else if (update.has_list_delta()) {
+			return ApplyListOps(update.list_delta(), peer->buff, [peer](const mq::proto::charinfo::ListOp& op) {
+				return ToPeerBuffEntry(op.spell(), peer->class_info.id, op.value(), peer->clock_offset);
+			});
 		}
 		break;
 	case Id::FIELD_buff_durations:
 		if (update.has_int32_list()) {
 			const auto& list = update.int32_list();
-			for (int i = 0; i < list.value_size() && i < static_cast<int>(peer->buff.size()); i++)
+			for (int i = 0; i < list.value_size() && i < static_cast<int>(peer->buff.size()); i++) {
 				peer->buff[static_cast<size_t>(i)].duration = list.value(i);
+				if (!expiries)
+					peer->buff[static_cast<size_t>(i)].expires_at = 0;
+			}
 		}
 		break;
 	case Id::FIELD_short_buff_spells:
@@ -996,22 +2518,25 @@ bool ApplyFieldUpdate(const mq::proto::charinfo::FieldUpdate& update, CharinfoPe
 			peer->short_buff.clear();
 			const int n = update.spell_list().spell_size();
 			for (int i = 0; i < n; i++) {
-				const auto& sp = update.spell_list().spell(i);
 				PeerBuffEntry e;
-				e.spell.name = sp.name();
-				e.spell.id = sp.id();
-				e.spell.category = sp.category();
-				e.spell.level = sp.level();
+				e.spell = ToPeerSpell(update.spell_list().spell(i), peer->class_info.id);
 				e.duration = -1;
 				peer->short_buff.push_back(std::move(e));
 			}
+		} else if (update.has_list_delta()) {
+			return ApplyListOps(update.list_delta(), peer->short_buff, [peer](const mq::proto::charinfo::ListOp& op) {
+				return ToPeerBuffEntry(op.spell(), peer->class_info.id, op.value(), peer->clock_offset);
+			});
 		}
 		break;
 	case Id::FIELD_short_buff_durations:
 		if (update.has_int32_list()) {
 			const auto& list = update.int32_list();
-			for (int i = 0; i < list.value_size() && i < static_cast<int>(peer->short_buff.size()); i++)
+			for (int i = 0; i < list.value_size() && i < static_cast<int>(peer->short_buff.size()); i++) {
 				peer->short_buff[static_cast<size_t>(i)].duration = list.value(i);
+				if (!expiries)
+					peer->short_buff[static_cast<size_t>(i)].expires_at = 0;
+			}
 		}
 		break;
 	case Id::FIELD_pet_buff_spells:
@@ -1019,24 +2544,41 @@ bool ApplyFieldUpdate(const mq::proto::charinfo::FieldUpdate& update, CharinfoPe
 			peer->pet_buff.clear();
 			const int n = update.spell_list().spell_size();
 			for (int i = 0; i < n; i++) {
-				const auto& sp = update.spell_list().spell(i);
 				PeerBuffEntry e;
-				e.spell.name = sp.name();
-				e.spell.id = sp.id();
-				e.spell.category = sp.category();
-				e.spell.level = sp.level();
+				e.spell = ToPeerSpell(update.spell_list().spell(i), peer->class_info.id);
 				e.duration = -1;
 				peer->pet_buff.push_back(std::move(e));
 			}
+		} else if (update.has_list_delta()) {
+			return ApplyListOps(update.list_delta(), peer->pet_buff, [peer](const mq::proto::charinfo::ListOp& op) {
+				return ToPeerBuffEntry(op.spell(), peer->class_info.id, op.value(), peer->clock_offset);
+			});
 		}
 		break;
 	case Id::FIELD_pet_buff_durations:
 		if (update.has_int32_list()) {
 			const auto& list = update.int32_list();
-			for (int i = 0; i < list.value_size() && i < static_cast<int>(peer->pet_buff.size()); i++)
+			for (int i = 0; i < list.value_size() && i < static_cast<int>(peer->pet_buff.size()); i++) {
 				peer->pet_buff[static_cast<size_t>(i)].duration = list.value(i);
+				if (!expiries)
+					peer->pet_buff[static_cast<size_t>(i)].expires_at = 0;
+			}
+		}
+		break;
+	case Id::FIELD_buff_expires:
+	case Id::FIELD_short_buff_expires:
+	case Id::FIELD_pet_buff_expires: {
+		std::vector<PeerBuffEntry>& entries = update.field_id() == Id::FIELD_buff_expires ? peer->buff
+			: update.field_id() == Id::FIELD_short_buff_expires ? peer->short_buff : peer->pet_buff;
+		if (update.has_int64_list()) {
+			const auto& list = update.int64_list();
+			for (int i = 0; i < list.value_size() && i < static_cast<int>(entries.size()); i++)
+				entries[static_cast<size_t>(i)].expires_at = ToLocalExpiry(list.value(i), peer->clock_offset);
+		} else if (update.has_list_delta()) {
+			return ApplyExpiryDelta(update.list_delta(), entries, peer->clock_offset);
 		}
 		break;
+	}
 	case Id::FIELD_free_buff_slots: if (update.has_i32()) peer->free_buff_slots = update.i32(); break;
 	case Id::FIELD_detrimentals: if (update.has_i32()) peer->detrimentals = update.i32(); break;
 	case Id::FIELD_count_poison: if (update.has_i32()) peer->count_poison = update.i32(); break;
@@ -1045,8 +2587,8 @@ bool ApplyFieldUpdate(const mq::proto::charinfo::FieldUpdate& update, CharinfoPe
 	case Id::FIELD_count_corruption: if (update.has_i32()) peer->count_corruption = update.i32(); break;
 	case Id::FIELD_pet_hp: if (update.has_i32()) peer->pet_hp = update.i32(); break;
 	case Id::FIELD_max_endurance: if (update.has_i32()) peer->max_endurance = update.i32(); break;
-	case Id::FIELD_current_hp: if (update.has_i32()) peer->current_hp = update.i32(); break;
-	case Id::FIELD_max_hp: if (update.has_i32()) peer->max_hp = update.i32(); break;
+	case Id::FIELD_current_hp: if (update.has_i64()) peer->current_hp = update.i64(); break;
+	case Id::FIELD_max_hp: if (update.has_i64()) peer->max_hp = update.i64(); break;
 	case Id::FIELD_current_mana: if (update.has_i32()) peer->current_mana = update.i32(); break;
 	case Id::FIELD_max_mana: if (update.has_i32()) peer->max_mana = update.i32(); break;
 	case Id::FIELD_current_endurance: if (update.has_i32()) peer->current_endurance = update.i32(); break;
@@ -1071,21 +2613,13 @@ bool ApplyFieldUpdate(const mq::proto::charinfo::FieldUpdate& update, CharinfoPe
 		if (update.has_int32_list()) {
 			peer->gems.clear();
 			PcProfile* profile = GetPcProfile();
-			for (int i = 0; i < update.int32_list().value_size(); i++) {
-				int32_t spellId = update.int32_list().value(i);
-				PeerGemEntry ge;
-				ge.id = spellId;
-				if (EQ_Spell* spell = GetSpellByID(spellId)) {
-					ge.name = spell->Name[0] ? spell->Name : "";
-					ge.category = spell->Category;
-					ge.level = profile ? static_cast<int32_t>(spell->GetSpellLevelNeeded(profile->Class)) : 0;
-				} else {
-					ge.name = "";
-					ge.category = 0;
-					ge.level = 0;
-				}
-				peer->gems.push_back(std::move(ge));
-			}
+			for (int i = 0; i < update.int32_list().value_size(); i++)
+				peer->gems.push_back(ResolveGem(update.int32_list().value(i), profile));
+		} else if (update.has_list_delta()) {
+			PcProfile* profile = GetPcProfile();
+			return ApplyListOps(update.list_delta(), peer->gems, [profile](const mq::proto::charinfo::ListOp& op) {
+				return ResolveGem(static_cast<int32_t>(op.value()), profile);
+			});
 		}
 		break;
 	case Id::FIELD_version: if (update.has_f()) peer->version = update.f(); break;
@@ -1128,20 +2662,13 @@ bool ApplyFieldUpdate(const mq::proto::charinfo::FieldUpdate& update, CharinfoPe
 		if (update.has_lua()) {
 			PeerLuaInfo lua;
 			lua.scripts.reserve(static_cast<size_t>(update.lua().scripts_size()));
-			for (int i = 0; i < update.lua().scripts_size(); ++i) {
-				const auto& src = update.lua().scripts(i);
-				PeerLuaScriptInfo dst;
-				dst.pid = src.pid();
-				dst.name = src.name();
-				dst.path = src.path();
-				dst.status = src.status();
-				dst.arguments.reserve(static_cast<size_t>(src.arguments_size()));
-				for (int arg = 0; arg < src.arguments_size(); ++arg)
-					dst.arguments.push_back(src.arguments(arg));
-				lua.scripts.push_back(std::move(dst));
-			}
+			for (int i = 0; i < update.lua().scripts_size(); ++i)
+				lua.scripts.push_back(ToPeerLuaScript(update.lua().scripts(i)));
 			peer->has_lua = true;
 			peer->lua = std::move(lua);
+		} else if (update.has_lua_delta()) {
+			peer->has_lua = true;
+			return ApplyPeerLuaDelta(update.lua_delta(), peer->lua);
 		}
 		break;
 	case Id::FIELD_free_inventory:
@@ -1151,11 +2678,162 @@ bool ApplyFieldUpdate(const mq::proto::charinfo::FieldUpdate& update, CharinfoPe
 				peer->free_inventory.push_back(update.int32_list().value(i));
 		}
 		break;
-	default: return false;
+	default:
+		// A field this build doesn't know (a newer sender): nothing to merge it into.
+		break;
 	}
 	return true;
 }
 
+// --- State checkpoints (2.2+) ---
+//
+// Both overloads feed the same values in the same order, so a receiver that applied every update
+// hashes to what the sender hashed from its last-published snapshot. Only values that cross the wire
+// exactly take part: floats (x100 in packed framing), expiries (rebased on the local clock) and
+// anything resolved from local spell data are left out. Lua scripts are upserted by PID, so their
+// order is not significant and they are combined order-independently.
+
+namespace {
+
+void AddCheckpointInt(Fingerprint& fp, int64_t value)
+{
+	fp.AddValue(value);
+}
+
+uint64_t LuaScriptChecksum(int32_t pid, std::string_view status)
+{
+	Fingerprint fp;
+	AddCheckpointInt(fp, pid);
+	fp.AddString(status);
+	return fp.Value();
+}
+
+uint64_t FinishChecksum(const Fingerprint& fp)
+{
+	// 0 means "no checkpoint" on the wire.
+	return fp.Value() != 0 ? fp.Value() : 1;
+}
+
+} // namespace
+
+uint64_t StateChecksum(const mq::proto::charinfo::CharinfoPublish& pub)
+{
+	Fingerprint fp;
+	fp.AddString(pub.name());
+	for (int64_t value : { int64_t(pub.id()), int64_t(pub.level()), int64_t(pub.class_info().id()),
+		int64_t(pub.pct_hps()), int64_t(pub.pct_mana()), int64_t(pub.target_hp()), int64_t(pub.free_buff_slots()),
+		int64_t(pub.detrimentals()), int64_t(pub.count_poison()), int64_t(pub.count_disease()),
+		int64_t(pub.count_curse()), int64_t(pub.count_corruption()), int64_t(pub.pet_hp()),
+		int64_t(pub.max_endurance()), pub.current_hp(), pub.max_hp(), int64_t(pub.current_mana()),
+		int64_t(pub.max_mana()), int64_t(pub.current_endurance()), int64_t(pub.pct_endurance()),
+		int64_t(pub.pet_id()), int64_t(pub.pet_affinity()), pub.no_cure(), pub.life_drain(), pub.mana_drain(),
+		pub.endu_drain(), int64_t(pub.state_bits()), int64_t(pub.detr_state_bits()),
+		int64_t(pub.bene_state_bits()), int64_t(pub.casting_spell_id()), int64_t(pub.combat_state()),
+		int64_t(pub.target().id()), int64_t(pub.zone().id()), int64_t(pub.zone().instance_id()) })
+		AddCheckpointInt(fp, value);
+	fp.AddString(pub.target().name());
+	fp.AddString(pub.zone().short_name());
+
+	for (const SpellList* list : { &pub.buff_spells(), &pub.short_buff_spells(), &pub.pet_buff_spells() }) {
+		AddCheckpointInt(fp, list->size());
+		for (const auto& spell : *list)
+			AddCheckpointInt(fp, spell.id());
+	}
+	AddCheckpointInt(fp, pub.gem_size());
+	for (int32_t gem : pub.gem())
+		AddCheckpointInt(fp, gem);
+	AddCheckpointInt(fp, pub.free_inventory_size());
+	for (int32_t count : pub.free_inventory())
+		AddCheckpointInt(fp, count);
+
+	const auto& ex = pub.experience();
+	for (int64_t value : { int64_t(ex.total_aa()), int64_t(ex.aa_spent()), int64_t(ex.aa_unused()), int64_t(ex.aa_assigned()) })
+		AddCheckpointInt(fp, value);
+	AddCheckpointInt(fp, pub.make_camp().status());
+	AddCheckpointInt(fp, pub.macro().macro_state());
+	fp.AddString(pub.macro().macro_name());
+
+	uint64_t scripts = 0;
+	for (const auto& script : pub.lua().scripts())
+		scripts += LuaScriptChecksum(script.pid(), script.status());
+	AddCheckpointInt(fp, pub.lua().scripts_size());
+	fp.AddValue(scripts);
+	return FinishChecksum(fp);
+}
+
+uint64_t StateChecksum(const CharinfoPeer& peer)
+{
+	Fingerprint fp;
+	fp.AddString(peer.name);
+	for (int64_t value : { int64_t(peer.id), int64_t(peer.level), int64_t(peer.class_info.id),
+		int64_t(peer.pct_hps), int64_t(peer.pct_mana), int64_t(peer.target_hp), int64_t(peer.free_buff_slots),
+		int64_t(peer.detrimentals), int64_t(peer.count_poison), int64_t(peer.count_disease),
+		int64_t(peer.count_curse), int64_t(peer.count_corruption), int64_t(peer.pet_hp),
+		int64_t(peer.max_endurance), peer.current_hp, peer.max_hp, int64_t(peer.current_mana),
+		int64_t(peer.max_mana), int64_t(peer.current_endurance), int64_t(peer.pct_endurance),
+		int64_t(peer.pet_id), int64_t(peer.pet_affinity), peer.no_cure, peer.life_drain, peer.mana_drain,
+		peer.endu_drain, int64_t(peer.state_bits), int64_t(peer.detr_state_bits),
+		int64_t(peer.bene_state_bits), int64_t(peer.casting_spell_id), int64_t(peer.combat_state),
+		int64_t(peer.target.id), int64_t(peer.zone.id), int64_t(peer.zone.instance_id) })
+		AddCheckpointInt(fp, value);
+	fp.AddString(peer.target.name);
+	fp.AddString(peer.zone.short_name);
+
+	for (const std::vector<PeerBuffEntry>* list : { &peer.buff, &peer.short_buff, &peer.pet_buff }) {
+		AddCheckpointInt(fp, static_cast<int64_t>(list->size()));
+		for (const PeerBuffEntry& entry : *list)
+			AddCheckpointInt(fp, entry.spell.id);
+	}
+	AddCheckpointInt(fp, static_cast<int64_t>(peer.gems.size()));
+	for (const PeerGemEntry& gem : peer.gems)
+		AddCheckpointInt(fp, gem.id);
+	AddCheckpointInt(fp, static_cast<int64_t>(peer.free_inventory.size()));
+	for (int32_t count : peer.free_inventory)
+		AddCheckpointInt(fp, count);
+
+	const PeerExperienceInfo& ex = peer.experience;
+	for (int64_t value : { int64_t(ex.total_aa), int64_t(ex.aa_spent), int64_t(ex.aa_unused), int64_t(ex.aa_assigned) })
+		AddCheckpointInt(fp, value);
+	AddCheckpointInt(fp, peer.make_camp.status);
+	AddCheckpointInt(fp, peer.macro.macro_state);
+	fp.AddString(peer.macro.macro_name);
+
+	uint64_t scripts = 0;
+	for (const PeerLuaScriptInfo& script : peer.lua.scripts)
+		scripts += LuaScriptChecksum(script.pid, script.status);
+	AddCheckpointInt(fp, static_cast<int64_t>(peer.lua.scripts.size()));
+	fp.AddValue(scripts);
+	return FinishChecksum(fp);
+}
+
+// --- Packed scalar framing (1.9+): encoding and decoding live in PackedUpdates.cpp ---
+
+namespace {
+
+template <typename Target>
+static bool ApplyPacked(const std::string& packed, Target* target)
+{
+	PackedUpdateReader reader(packed);
+	mq::proto::charinfo::FieldUpdate update;
+	while (reader.Next(&update)) {
+		if (!ApplyFieldUpdate(update, target))
+			return false;
+	}
+	return !reader.Failed();
+}
+
+} // namespace
+
+bool ApplyPackedUpdates(const std::string& packed, mq::proto::charinfo::CharinfoPublish* peer)
+{
+	return ApplyPacked(packed, peer);
+}
+
+bool ApplyPackedUpdates(const std::string& packed, CharinfoPeer* peer)
+{
+	return ApplyPacked(packed, peer);
+}
+
 bool StacksForPeer(const CharinfoPeer& peer, const char* spellNameOrId)
 {
 	if (!spellNameOrId || !spellNameOrId[0])
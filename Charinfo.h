@@ -2,6 +2,7 @@
 
 #include "CharinfoPeer.h"
 #include "charinfo.pb.h"
+#include <cstdint>
 #include <unordered_map>
 #include <memory>
 #include <string>
@@ -10,20 +11,281 @@
 namespace charinfo {
 
 // Version constant; bump when making breaking or notable changes.
-constexpr float CHARINFO_VERSION = 1.5f;
+constexpr float CHARINFO_VERSION = 3.0f;
+
+// Oldest receiver version that derives buff timers from *_buff_expires; older ones need *_buff_durations.
+constexpr float CHARINFO_VERSION_BUFF_EXPIRES = 1.6f;
+
+// Oldest receiver version that understands ListDelta / LuaInfoDelta field updates.
+constexpr float CHARINFO_VERSION_LIST_DELTAS = 1.7f;
+
+// Oldest receiver version that resolves ID-only SpellInfo entries from its own spell data.
+constexpr float CHARINFO_VERSION_COMPACT_SPELLS = 1.8f;
+
+// Oldest receiver version that decodes CharinfoUpdate.packed.
+constexpr float CHARINFO_VERSION_PACKED_UPDATES = 1.9f;
+
+// Oldest receiver version that unwraps compressed CharinfoMessage envelopes.
+constexpr float CHARINFO_VERSION_COMPRESSION = 2.0f;
+
+// Oldest version that advertises held snapshot versions in Joined and answers them with
+// Unchanged or replayed updates; senders zone in with an update instead of a full publish.
+constexpr float CHARINFO_VERSION_SNAPSHOT_HANDSHAKE = 2.3f;
+
+// Oldest version that advertises its section subscriptions; older peers are assumed to read everything.
+constexpr float CHARINFO_VERSION_SUBSCRIPTIONS = 2.4f;
+
+// Oldest receiver version that extrapolates PositionInfo fixes; zone updates to it carry identity only.
+constexpr float CHARINFO_VERSION_POSITION = 2.5f;
+
+// Oldest receiver version that resolves session string tokens in publishes and updates.
+constexpr float CHARINFO_VERSION_SESSION_STRINGS = 2.6f;
+
+// Oldest version that relays updates through an elected hub and applies CharinfoBatch.
+constexpr float CHARINFO_VERSION_HUB = 2.7f;
+
+// Oldest receiver version that decodes COMPRESSION_ZSTD_DICT_V2 (trained dictionary) frames.
+constexpr float CHARINFO_VERSION_TRAINED_DICTIONARY = 3.0f;
 
 // In-memory peer state keyed by sender (character) name.
 using PeerMap = std::unordered_map<std::string, std::shared_ptr<CharinfoPeer>>;
 
 PeerMap& GetPeers();
 
+// Lowest protocol version among known peers (CHARINFO_VERSION when there are none).
+float MinPeerVersion();
+
+// Outbound traffic counters for the settings panel.
+struct PublishStats {
+	uint64_t messages = 0;
+	uint64_t full_publishes = 0;
+	uint64_t updates = 0;
+	uint64_t bytes = 0;
+	int64_t started_ms = 0; // ClockMs() when counting started
+	// Packed scalar framing: updates and fields packed, packed bytes, what they would have cost
+	// as FieldUpdates, and time spent packing.
+	uint64_t packed_updates = 0;
+	uint64_t packed_fields = 0;
+	uint64_t packed_bytes = 0;
+	uint64_t packed_field_update_bytes = 0;
+	uint64_t pack_ns = 0;
+	// Update sequencing: gaps seen in peers' update streams, stale updates dropped, resync
+	// requests sent, and full publishes sent in answer to a peer's request.
+	uint64_t sequence_gaps = 0;
+	uint64_t stale_updates = 0;
+	uint64_t resync_requests = 0;
+	uint64_t resync_replies = 0;
+	// Checkpoints: sent, verified against a peer, and verified but not matching (divergence).
+	uint64_t checkpoints_sent = 0;
+	uint64_t checkpoints_verified = 0;
+	uint64_t checkpoint_mismatches = 0;
+	// Joined replies: full publishes sent to a single joiner, broadcasts that answered several,
+	// and joins that were folded into an already scheduled reply.
+	uint64_t join_replies_directed = 0;
+	uint64_t join_reply_broadcasts = 0;
+	uint64_t joins_coalesced = 0;
+	// Joiners that already held our snapshot (answered "unchanged") or a recent version of it
+	// (answered with the updates they missed), and the number of updates replayed.
+	uint64_t join_replies_unchanged = 0;
+	uint64_t join_replies_replayed = 0;
+	uint64_t replayed_updates = 0;
+	// Position-only updates, how many went out as broadcasts, and directed posts for the rest.
+	uint64_t position_updates = 0;
+	uint64_t position_broadcasts = 0;
+	uint64_t position_directed_posts = 0;
+	// Dead reckoning: position samples that produced a new fix, and samples the last fix still
+	// predicted within the threshold (nothing sent).
+	uint64_t position_fixes = 0;
+	uint64_t position_predicted = 0;
+	// Session strings: strings sent as a token instead of inline, the bytes that saved, and
+	// definitions (first use, or first use after a full publish).
+	uint64_t session_string_refs = 0;
+	uint64_t session_string_bytes_saved = 0;
+	uint64_t session_string_definitions = 0;
+	// Hub mode: batches broadcast as hub and the updates they carried, updates posted to the hub,
+	// hubs given up on, and our updates re-broadcast because a hub may not have relayed them.
+	uint64_t hub_batches = 0;
+	uint64_t hub_batched_updates = 0;
+	uint64_t hub_relayed_updates = 0;
+	uint64_t hub_failovers = 0;
+	uint64_t hub_resent_updates = 0;
+	// Inbound: messages handled, peer updates applied (direct or from batches), and time spent
+	// handling them (microseconds).
+	uint64_t received_messages = 0;
+	uint64_t received_updates = 0;
+	uint64_t receive_us = 0;
+	// Peer updates that didn't apply to our copy of the sender (a list delta that doesn't fit, or
+	// malformed packed fields); each one stops the update and requests a resync.
+	uint64_t update_apply_failures = 0;
+	// Peer snapshots taken from other clients' shared-memory slots, and writes of our own that
+	// found no slot (updates then go by postoffice). Vitals-only changes written to our slot, and
+	// read from peers' slots without parsing a snapshot.
+	uint64_t shared_snapshots_read = 0;
+	uint64_t shared_snapshot_write_failures = 0;
+	uint64_t shared_vitals_writes = 0;
+	uint64_t shared_vitals_read = 0;
+	// Home channel changes made by Channel=auto.
+	uint64_t channel_switches = 0;
+	// Updates split into lanes: priority-lane updates and the bulk-lane pieces after them, the
+	// bulk field bytes those pieces carried, and single fields over the cap (sent alone).
+	uint64_t priority_updates = 0;
+	uint64_t bulk_updates = 0;
+	uint64_t bulk_bytes = 0;
+	uint64_t bulk_oversized_fields = 0;
+	// Batched priority updates applied ahead of bulk updates received before them.
+	uint64_t priority_applied_first = 0;
+};
+
+PublishStats& GetPublishStats();
+
+// Groups of CharinfoPublish fields that are sampled, rebuilt and diffed together.
+enum class PublishSection : uint32_t {
+	Identity,   // sender, name, id, level, class_info, version
+	Vitals,     // hp/mana/endurance, state bits, casting_spell_id, combat_state
+	Target,     // target, target_hp
+	Zone,       // zone (ids, names, position)
+	Buffs,      // long/short buff spells, free_buff_slots, detrimentals, counters
+	BuffTimers, // buff/short/pet buff durations
+	Pet,        // pet_id, pet_hp, pet_affinity, pet buff spells
+	Gems,
+	Experience,
+	MakeCamp,
+	Macro,
+	Lua,
+	Inventory,  // free_inventory
+	Count
+};
+
+using SectionMask = uint32_t;
+
+constexpr SectionMask SectionBit(PublishSection section) { return 1u << static_cast<uint32_t>(section); }
+constexpr SectionMask kAllSections = (1u << static_cast<uint32_t>(PublishSection::Count)) - 1;
+
+// Section name as used for INI keys (e.g. "Vitals", "BuffTimers").
+const char* SectionName(PublishSection section);
+
+// Record that local code (Lua, the settings panel) read peer fields from these sections.
+void NoteSectionRead(SectionMask sections);
+
+// Sections read within the last windowMs: this client's subscription.
+SectionMask RecentlyReadSections(int64_t windowMs);
+
+// Treat every section as just read, so a fresh client subscribes to everything until its
+// readers have had a chance to run.
+void ResetSectionReads();
+
 // Build current character state into a CharinfoPublish. Returns false if not in game.
+// Buff SpellInfo entries carry only the spell ID.
 bool BuildPublishPayload(mq::proto::charinfo::CharinfoPublish* out);
 
-// Build delta update from current vs previous state. Returns true if updates were added.
+// Fill name, category and level of every buff SpellInfo, for receivers older than 1.8.
+void ExpandSpellInfos(mq::proto::charinfo::CharinfoPublish* publish);
+
+// Keeps a cheap fingerprint of the game values behind each PublishSection and rebuilds only the
+// sections of a persistent snapshot whose fingerprint changed since the previous sample.
+class PublishSampler {
+public:
+	// Sample the requested sections into snapshot; *dirty receives the sections that were rebuilt.
+	// Returns false if not in game.
+	bool Sample(mq::proto::charinfo::CharinfoPublish* snapshot, SectionMask* dirty,
+		SectionMask sections = kAllSections);
+
+	// Forget all fingerprints so the next Sample rebuilds every requested section.
+	void Reset();
+
+private:
+	uint64_t m_fingerprints[static_cast<size_t>(PublishSection::Count)] = {};
+	SectionMask m_valid = 0;
+};
+
+// Dead-reckoning sender side: keeps the last published PositionInfo fix and replaces it only when
+// extrapolating that fix misses the sampled zone position by more than a threshold (units), or
+// the heading turned. Velocity is estimated from successive samples.
+class PositionTracker {
+public:
+	// Compare the snapshot's zone position (sampled at nowMs) against the current fix. Writes a new
+	// fix into snapshot->position and returns true when one is needed; otherwise leaves the
+	// previous fix in place.
+	bool Update(mq::proto::charinfo::CharinfoPublish* snapshot, int64_t nowMs, float threshold);
+
+	// Forget the fix and samples; the next Update always writes a fix.
+	void Reset();
+
+private:
+	mq::proto::charinfo::PositionInfo m_fix;
+	bool m_hasFix = false;
+	int32_t m_zoneId = 0;
+	int32_t m_instanceId = 0;
+	float m_lastX = 0, m_lastY = 0, m_lastZ = 0;
+	int64_t m_lastMs = 0;
+};
+
+// Sender side of the session string dictionary (2.6+). Repeated strings (target, zone, class and
+// macro names, Lua script names and paths) get a small token on first use; later updates send the
+// token alone once every receiver has seen it defined.
+class SessionStrings {
+public:
+	// Fill publish->string_tokens for a full publish. Receivers rebuild their table from it, so only
+	// its strings stay defined; any other token is defined again on next use.
+	void Keyframe(mq::proto::charinfo::CharinfoPublish* publish);
+
+	// Fill publish->string_tokens for a full publish addressed to one peer. Only that peer rebuilds
+	// its table, so a string stays defined only if it already was and travels in this publish.
+	void Carry(mq::proto::charinfo::CharinfoPublish* publish);
+
+	// Replace defined strings in the update's FieldUpdates with their tokens and fill string_tokens.
+	void Tokenize(mq::proto::charinfo::CharinfoUpdate* update);
+
+	// Mark every token undefined (a full publish went out without string_tokens).
+	void Undefine();
+
+	void Reset();
+
+private:
+	struct Entry {
+		uint32_t token = 0;
+		bool defined = false;
+	};
+	Entry& Intern(const std::string& value);
+
+	std::unordered_map<std::string, Entry> m_entries;
+	uint32_t m_nextToken = 1;
+};
+
+// Resolve the session string tokens of an update from the sender's table, defining new ones.
+// Returns false if the update refers to a token the table does not hold (resync needed).
+bool ResolveSessionStrings(mq::proto::charinfo::CharinfoUpdate* update, CharinfoPeer* peer);
+
+// Free-inventory tracking: bag containers are rescanned only after an inventory change is signalled.
+// None of the signals tells which bag changed, so every bag is rescanned.
+void InvalidateInventory();
+
+// Per-pulse O(1) check of the cursor item; a pickup or drop invalidates the inventory counts.
+void NoteInventoryCursor();
+
+// Build delta update from current vs previous state, comparing only the given sections.
+// peerVersion is the oldest receiver's version and selects which encodings may be used.
+// Returns true if updates were added.
 bool BuildUpdatePayload(const mq::proto::charinfo::CharinfoPublish& current,
 	const mq::proto::charinfo::CharinfoPublish& previous,
-	mq::proto::charinfo::CharinfoUpdate* out);
+	mq::proto::charinfo::CharinfoUpdate* out,
+	SectionMask sections = kAllSections,
+	float peerVersion = CHARINFO_VERSION);
+
+// Copy the fields owned by the given sections from one snapshot into another, reusing the
+// destination's storage. Used to keep the last-published snapshot in sync after an update.
+void CopySections(const mq::proto::charinfo::CharinfoPublish& from,
+	mq::proto::charinfo::CharinfoPublish* to,
+	SectionMask sections);
+
+// Checkpoint hash of the state a receiver rebuilds from this snapshot; compare with
+// StateChecksum(const CharinfoPeer&). Never 0.
+uint64_t StateChecksum(const mq::proto::charinfo::CharinfoPublish& pub);
+
+// Decode CharinfoUpdate.packed and apply each field. Returns false on malformed input or a
+// field that failed to apply; the fields before it are applied.
+bool ApplyPackedUpdates(const std::string& packed, mq::proto::charinfo::CharinfoPublish* peer);
+bool ApplyPackedUpdates(const std::string& packed, CharinfoPeer* peer);
 
 // Apply a single FieldUpdate to an existing CharinfoPublish (receiver merge). Returns true if applied.
 // Used when building update payloads from current vs previous protobuf state.
@@ -6,11 +6,14 @@
 #include "CharinfoPanel.h"
 #include "Charinfo.h"
 #include "CharinfoPeer.h"
+#include "Compression.h"
+#include "SpellCache.h"
 #include "mq/Plugin.h"
 
 #include <imgui.h>
 
 #include <algorithm>
+#include <map>
 #include <string>
 #include <vector>
 
@@ -248,17 +251,17 @@ static void DrawPeerData(const charinfo::CharinfoPeer& peer)
 		ImGui::TableSetColumnIndex(0);
 		ImGui::Text("X");
 		ImGui::TableSetColumnIndex(1);
-		ImGui::Text("%.2f", peer.zone.x);
+		ImGui::Text("%.2f", peer.zone.X());
 		ImGui::TableNextRow();
 		ImGui::TableSetColumnIndex(0);
 		ImGui::Text("Y");
 		ImGui::TableSetColumnIndex(1);
-		ImGui::Text("%.2f", peer.zone.y);
+		ImGui::Text("%.2f", peer.zone.Y());
 		ImGui::TableNextRow();
 		ImGui::TableSetColumnIndex(0);
 		ImGui::Text("Z");
 		ImGui::TableSetColumnIndex(1);
-		ImGui::Text("%.2f", peer.zone.z);
+		ImGui::Text("%.2f", peer.zone.Z());
 		ImGui::TableNextRow();
 		ImGui::TableSetColumnIndex(0);
 		ImGui::Text("Heading");
@@ -268,8 +271,8 @@ static void DrawPeerData(const charinfo::CharinfoPeer& peer)
 		ImGui::TableSetColumnIndex(0);
 		ImGui::Text("Distance");
 		ImGui::TableSetColumnIndex(1);
-		if (peer.zone.distance >= 0)
-			ImGui::Text("%.1f", peer.zone.distance);
+		if (const double distance = charinfo::ZoneDistance(peer.zone); distance >= 0)
+			ImGui::Text("%.1f", distance);
 		else
 			ImGui::TextUnformatted("—");
 		ImGui::TreePop();
@@ -417,7 +420,7 @@ static void DrawPeerData(const charinfo::CharinfoPeer& peer)
 			ImGui::TableSetColumnIndex(0);
 			ImGui::Text("[%zu] Duration", i + 1);
 			ImGui::TableSetColumnIndex(1);
-			ImGui::Text("%d", entry.duration);
+			ImGui::Text("%d", entry.Remaining());
 			ImGui::TableNextRow();
 			ImGui::TableSetColumnIndex(0);
 			ImGui::Text("[%zu] Spell Name", i + 1);
@@ -452,7 +455,7 @@ static void DrawPeerData(const charinfo::CharinfoPeer& peer)
 			ImGui::TableSetColumnIndex(0);
 			ImGui::Text("[%zu] Duration", i + 1);
 			ImGui::TableSetColumnIndex(1);
-			ImGui::Text("%d", entry.duration);
+			ImGui::Text("%d", entry.Remaining());
 			ImGui::TableNextRow();
 			ImGui::TableSetColumnIndex(0);
 			ImGui::Text("[%zu] Spell Name", i + 1);
@@ -477,7 +480,7 @@ static void DrawPeerData(const charinfo::CharinfoPeer& peer)
 			ImGui::TableSetColumnIndex(0);
 			ImGui::Text("[%zu] Duration", i + 1);
 			ImGui::TableSetColumnIndex(1);
-			ImGui::Text("%d", entry.duration);
+			ImGui::Text("%d", entry.Remaining());
 			ImGui::TableNextRow();
 			ImGui::TableSetColumnIndex(0);
 			ImGui::Text("[%zu] Spell Name", i + 1);
@@ -493,10 +496,127 @@ static void DrawPeerData(const charinfo::CharinfoPeer& peer)
 	}
 }
 
+static void DrawStatistics()
+{
+	if (!ImGui::CollapsingHeader("Statistics"))
+		return;
+
+	const charinfo::SpellCacheStats& spells = charinfo::GetSpellCacheStats();
+	const uint64_t lookups = spells.hits + spells.misses;
+	ImGui::Text("Spell cache: %zu entries, %llu hits, %llu misses (%.1f%% hit rate), %llu invalidations",
+		spells.entries, static_cast<unsigned long long>(spells.hits), static_cast<unsigned long long>(spells.misses),
+		lookups ? 100.0 * static_cast<double>(spells.hits) / static_cast<double>(lookups) : 0.0,
+		static_cast<unsigned long long>(spells.invalidations));
+
+	const charinfo::PublishStats& sent = charinfo::GetPublishStats();
+	const double seconds = sent.started_ms ? static_cast<double>(charinfo::ClockMs() - sent.started_ms) / 1000.0 : 0.0;
+	ImGui::Text("Sent: %llu messages (%llu full, %llu updates), %llu bytes (%.1f B/s)",
+		static_cast<unsigned long long>(sent.messages), static_cast<unsigned long long>(sent.full_publishes),
+		static_cast<unsigned long long>(sent.updates), static_cast<unsigned long long>(sent.bytes),
+		seconds > 0.0 ? static_cast<double>(sent.bytes) / seconds : 0.0);
+	if (sent.received_messages > 0) {
+		ImGui::Text("Received: %llu messages (%.1f/s), %llu peer updates, %.1f us per message",
+			static_cast<unsigned long long>(sent.received_messages),
+			seconds > 0.0 ? static_cast<double>(sent.received_messages) / seconds : 0.0,
+			static_cast<unsigned long long>(sent.received_updates),
+			static_cast<double>(sent.receive_us) / static_cast<double>(sent.received_messages));
+	}
+	if (sent.shared_snapshots_read + sent.shared_vitals_read + sent.shared_vitals_writes + sent.shared_snapshot_write_failures > 0)
+		ImGui::Text("Shared memory: %llu peer snapshots read, %llu peer vitals read, %llu vitals written, %llu writes without a slot",
+			static_cast<unsigned long long>(sent.shared_snapshots_read), static_cast<unsigned long long>(sent.shared_vitals_read),
+			static_cast<unsigned long long>(sent.shared_vitals_writes),
+			static_cast<unsigned long long>(sent.shared_snapshot_write_failures));
+	std::map<std::string, int> channelPeers;
+	for (const auto& [name, peer] : charinfo::GetPeers()) {
+		if (peer)
+			channelPeers[peer->channel]++;
+	}
+	if (sent.channel_switches > 0 || channelPeers.size() > 1 || (channelPeers.size() == 1 && !channelPeers.begin()->first.empty())) {
+		std::string channels;
+		for (const auto& [channel, count] : channelPeers) {
+			if (!channels.empty())
+				channels += ", ";
+			channels += (channel.empty() ? std::string("default") : channel) + " " + std::to_string(count);
+		}
+		ImGui::Text("Channels: %s peers, %llu switches", channels.c_str(), static_cast<unsigned long long>(sent.channel_switches));
+	}
+	if (sent.packed_updates > 0) {
+		ImGui::Text("Packed scalars: %llu fields, %llu bytes (%llu as FieldUpdates), %.0f ns per update",
+			static_cast<unsigned long long>(sent.packed_fields), static_cast<unsigned long long>(sent.packed_bytes),
+			static_cast<unsigned long long>(sent.packed_field_update_bytes),
+			static_cast<double>(sent.pack_ns) / static_cast<double>(sent.packed_updates));
+	}
+	if (sent.sequence_gaps + sent.stale_updates + sent.resync_requests + sent.resync_replies + sent.update_apply_failures > 0) {
+		ImGui::Text("Sequencing: %llu gaps, %llu stale updates dropped, %llu failed to apply, %llu resyncs requested, %llu answered",
+			static_cast<unsigned long long>(sent.sequence_gaps), static_cast<unsigned long long>(sent.stale_updates),
+			static_cast<unsigned long long>(sent.update_apply_failures),
+			static_cast<unsigned long long>(sent.resync_requests), static_cast<unsigned long long>(sent.resync_replies));
+	}
+	if (sent.checkpoints_sent + sent.checkpoints_verified > 0) {
+		ImGui::Text("Checkpoints: %llu sent, %llu verified, %llu divergent",
+			static_cast<unsigned long long>(sent.checkpoints_sent), static_cast<unsigned long long>(sent.checkpoints_verified),
+			static_cast<unsigned long long>(sent.checkpoint_mismatches));
+	}
+	if (sent.join_replies_directed + sent.join_reply_broadcasts > 0) {
+		ImGui::Text("Join replies: %llu directed, %llu broadcast, %llu joins coalesced",
+			static_cast<unsigned long long>(sent.join_replies_directed), static_cast<unsigned long long>(sent.join_reply_broadcasts),
+			static_cast<unsigned long long>(sent.joins_coalesced));
+	}
+	if (sent.join_replies_unchanged + sent.join_replies_replayed > 0) {
+		ImGui::Text("Rejoins served without a snapshot: %llu unchanged, %llu replayed (%llu updates)",
+			static_cast<unsigned long long>(sent.join_replies_unchanged), static_cast<unsigned long long>(sent.join_replies_replayed),
+			static_cast<unsigned long long>(sent.replayed_updates));
+	}
+	if (sent.position_updates > 0) {
+		ImGui::Text("Position updates: %llu (%llu broadcast, %llu directed posts to same-zone peers)",
+			static_cast<unsigned long long>(sent.position_updates), static_cast<unsigned long long>(sent.position_broadcasts),
+			static_cast<unsigned long long>(sent.position_directed_posts));
+	}
+	if (sent.position_fixes + sent.position_predicted > 0) {
+		ImGui::Text("Position fixes: %llu (%llu samples predicted by the last fix)",
+			static_cast<unsigned long long>(sent.position_fixes), static_cast<unsigned long long>(sent.position_predicted));
+	}
+	if (sent.session_string_refs + sent.session_string_definitions > 0) {
+		ImGui::Text("Session strings: %llu sent as tokens (%llu bytes saved), %llu definitions",
+			static_cast<unsigned long long>(sent.session_string_refs), static_cast<unsigned long long>(sent.session_string_bytes_saved),
+			static_cast<unsigned long long>(sent.session_string_definitions));
+	}
+	if (sent.hub_batches + sent.hub_relayed_updates + sent.hub_failovers > 0) {
+		ImGui::Text("Hub: %llu batches carrying %llu updates, %llu updates posted to the hub, %llu failovers (%llu updates re-sent)",
+			static_cast<unsigned long long>(sent.hub_batches), static_cast<unsigned long long>(sent.hub_batched_updates),
+			static_cast<unsigned long long>(sent.hub_relayed_updates), static_cast<unsigned long long>(sent.hub_failovers),
+			static_cast<unsigned long long>(sent.hub_resent_updates));
+	}
+	if (sent.priority_updates + sent.bulk_updates + sent.priority_applied_first > 0) {
+		ImGui::Text("Lanes: %llu priority updates, %llu bulk pieces (%.0f B avg, %llu oversized fields), %llu batched priority updates applied first",
+			static_cast<unsigned long long>(sent.priority_updates), static_cast<unsigned long long>(sent.bulk_updates),
+			sent.bulk_updates > 0 ? static_cast<double>(sent.bulk_bytes) / static_cast<double>(sent.bulk_updates) : 0.0,
+			static_cast<unsigned long long>(sent.bulk_oversized_fields), static_cast<unsigned long long>(sent.priority_applied_first));
+	}
+
+	const charinfo::CompressionStats& zstd = charinfo::GetCompressionStats();
+	const uint64_t attempts = zstd.compressed + zstd.skipped;
+	if (attempts > 0) {
+		ImGui::Text("Compression: %llu of %llu publishes, %llu -> %llu bytes (%.2fx), %.1f us per publish",
+			static_cast<unsigned long long>(zstd.compressed), static_cast<unsigned long long>(attempts),
+			static_cast<unsigned long long>(zstd.raw_bytes), static_cast<unsigned long long>(zstd.compressed_bytes),
+			zstd.compressed_bytes ? static_cast<double>(zstd.raw_bytes) / static_cast<double>(zstd.compressed_bytes) : 0.0,
+			static_cast<double>(zstd.compress_ns) / 1000.0 / static_cast<double>(attempts));
+	}
+	if (zstd.decompressed + zstd.failures > 0) {
+		ImGui::Text("Decompression: %llu messages, %.1f us per message, %llu failures",
+			static_cast<unsigned long long>(zstd.decompressed),
+			zstd.decompressed ? static_cast<double>(zstd.decompress_ns) / 1000.0 / static_cast<double>(zstd.decompressed) : 0.0,
+			static_cast<unsigned long long>(zstd.failures));
+	}
+}
+
 } // namespace
 
 void DrawCharinfoPanel()
 {
+	DrawStatistics();
+
 	std::vector<std::string> names;
 	const PeerMap& peers = charinfo::GetPeers();
 	names.reserve(peers.size());
@@ -509,6 +629,8 @@ void DrawCharinfoPanel()
 	}
 
 	std::sort(names.begin(), names.end());
+	// The panel shows every field, so while it is open this client subscribes to everything.
+	charinfo::NoteSectionRead(charinfo::kAllSections);
 
 	const ImGuiTableFlags tableFlags = ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersOuter
 		| ImGuiTableFlags_BordersV | ImGuiTableFlags_Resizable | ImGuiTableFlags_SizingStretchSame;
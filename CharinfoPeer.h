@@ -1,12 +1,15 @@
 #pragma once
 
 #include "charinfo.pb.h"
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
 
 namespace charinfo {
 
+struct SharedVitals;
+
 // Lua-shaped types: match the exact structure exposed to Lua (peer.Buff[i].Spell, peer.Zone.Distance, etc.).
 
 struct PeerSpellInfo {
@@ -16,9 +19,18 @@ struct PeerSpellInfo {
 	int32_t level = 0;
 };
 
+// Local steady clock in milliseconds; the time base for buff expiries on both ends.
+int64_t ClockMs();
+
 struct PeerBuffEntry {
 	PeerSpellInfo spell;
+	// Duration as sent by peers older than 1.6 (or in a full publish); used when expires_at is 0.
 	int32_t duration = -1;
+	// Expiry on the local clock (ms); 0 = not known or permanent.
+	int64_t expires_at = 0;
+
+	// Remaining duration in ms (-1 = permanent / unknown), computed from expires_at when known.
+	int32_t Remaining() const;
 };
 
 struct PeerClassInfo {
@@ -37,11 +49,21 @@ struct PeerZoneInfo {
 	std::string short_name;
 	int32_t id = 0;
 	int32_t instance_id = 0;
+	// Position at the last fix; peers 2.5+ also send a velocity (units/s) that X/Y/Z extrapolate along.
 	float x = 0, y = 0, z = 0, heading = 0;
-	// Client-side distance when in same zone; negative = nil in Lua.
-	double distance = -1.0;
+	float vx = 0, vy = 0, vz = 0;
+	// Local clock (ms) of the fix; 0 = no velocity (position as sent).
+	int64_t fix_ms = 0;
+
+	// Extrapolated position now, capped at a few seconds past the fix.
+	float X() const;
+	float Y() const;
+	float Z() const;
 };
 
+// Client-side distance to the peer's extrapolated position when in the same zone; negative = nil in Lua.
+double ZoneDistance(const PeerZoneInfo& zone);
+
 struct PeerExperienceInfo {
 	float pct_exp = 0;
 	float pct_aa_exp = 0;
@@ -109,6 +131,16 @@ public:
 	int32_t casting_spell_id = 0;
 	int32_t combat_state = 0;
 	float version = 0;
+	// Local clock minus sender clock (ms), refreshed from every publish/update that carries clock_ms.
+	int64_t clock_offset = 0;
+	// Sequence number of the last update applied from this peer (0 = unsequenced sender).
+	uint32_t seq = 0;
+	// Session string table (2.6+) indexed by token, rebuilt from each full publish.
+	std::vector<std::string> session_strings;
+	// Read from the peer's shared-memory slot (same machine); its postoffice updates are ignored.
+	bool shared_memory = false;
+	// Channel the peer publishes on ("" = the default channel): ours, or one we listen to.
+	std::string channel;
 
 	// Nested
 	PeerClassInfo class_info;
@@ -137,9 +169,16 @@ private:
 // Build CharinfoPeer from a full Publish (includes Zone.Distance when in same zone).
 CharinfoPeer FromPublish(const mq::proto::charinfo::CharinfoPublish& pub);
 
+// Overwrite the peer's Vitals and Target sections with those read from its shared-memory slot.
+void ApplySharedVitals(const SharedVitals& vitals, CharinfoPeer* peer);
+
 // Apply a single FieldUpdate to an existing CharinfoPeer. Recomputes Zone.Distance when zone is updated.
+// Returns false when a list delta doesn't fit the peer's list (our copy is out of step with the sender).
 bool ApplyFieldUpdate(const mq::proto::charinfo::FieldUpdate& update, CharinfoPeer* peer);
 
+// Checkpoint hash of a peer's state; matches StateChecksum of the sender's snapshot when in sync.
+uint64_t StateChecksum(const CharinfoPeer& peer);
+
 // Stacks / StacksPet using CharinfoPeer data.
 bool StacksForPeer(const CharinfoPeer& peer, const char* spellNameOrId);
 bool StacksPetForPeer(const CharinfoPeer& peer, const char* spellNameOrId);
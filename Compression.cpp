@@ -0,0 +1,158 @@
+/*
+ * MQCharinfo - Optional zstd compression for full publishes, primed with a built-in dictionary.
+ */
+
+#include "Compression.h"
+#include "CompressionDictionary.h"
+
+#include <zstd.h>
+
+#include <chrono>
+
+namespace charinfo {
+
+namespace {
+
+// ZSTD_DICT_V1 raw-content dictionary: strings that recur in every full publish (class names, zones, buff
+// name fragments, Lua paths). zstd treats any buffer without the dictionary magic as raw content,
+// so matches against it cost a back-reference instead of a literal. Most frequent content goes
+// last, where offsets are shortest. Changing this text breaks decoding with older builds: add a
+// new CompressionKind instead.
+const char kDictionary[] =
+	"The Plane of KnowledgepoknowledgeThe Guild LobbyguildlobbyThe Guild HallguildhallThe Bazaarbazaar"
+	"Plane of TranquilitypotranquilityThe Nexusnexus"
+	"Illusion: Aura of the Talisman of the Symbol of the Shield of the Blessing of the Spirit of the "
+	"Voice of the Unity of the Growth of Regeneration Haste Resist Focus of Ward of Strength of "
+	"Brell's Virtue Aegolism Conviction Heroic Bond Clarity Gift of Boon of Chant of Song of "
+	"Form of Rk. IIIRk. IIRk. II"
+	"Lua/lua/init.luaRUNNINGPAUSEDEXITEDfalsetrue"
+	"WarriorWARClericCLRPaladinPALRangerRNGShadow KnightSHDDruidDRUMonkMNKBardBRDRogueROG"
+	"ShamanSHMNecromancerNECWizardWIZMagicianMAGEnchanterENCBeastlordBSTBerserkerBER";
+
+constexpr int kCompressionLevel = 3;
+// Full publishes are a few KB; anything this large is corrupt or hostile.
+constexpr unsigned long long kMaxDecompressedSize = 256 * 1024;
+
+CompressionStats s_stats;
+
+uint64_t ElapsedNs(std::chrono::steady_clock::time_point start)
+{
+	return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now() - start).count());
+}
+
+// The dictionary a CompressionKind primes its frames with. V2 is the zstd-trained dictionary in
+// CompressionDictionary.h (see bench/train_dictionary.py).
+bool DictionaryFor(mq::proto::charinfo::CompressionKind kind, const void** data, size_t* size)
+{
+	switch (kind) {
+	case mq::proto::charinfo::COMPRESSION_ZSTD_DICT_V1:
+		*data = kDictionary;
+		*size = sizeof(kDictionary) - 1;
+		return true;
+	case mq::proto::charinfo::COMPRESSION_ZSTD_DICT_V2:
+		*data = kTrainedDictionary;
+		*size = sizeof(kTrainedDictionary);
+		return true;
+	default:
+		return false;
+	}
+}
+
+constexpr int kDictionaryKinds = mq::proto::charinfo::CompressionKind_MAX + 1;
+
+// Contexts and digested dictionaries are built on first use and kept for the life of the plugin.
+ZSTD_CCtx* CompressContext()
+{
+	static ZSTD_CCtx* s_cctx = ZSTD_createCCtx();
+	return s_cctx;
+}
+
+const ZSTD_CDict* CompressDictionary(mq::proto::charinfo::CompressionKind kind)
+{
+	static ZSTD_CDict* s_cdicts[kDictionaryKinds] = {};
+	const void* data = nullptr;
+	size_t size = 0;
+	if (!DictionaryFor(kind, &data, &size))
+		return nullptr;
+	if (!s_cdicts[kind])
+		s_cdicts[kind] = ZSTD_createCDict(data, size, kCompressionLevel);
+	return s_cdicts[kind];
+}
+
+ZSTD_DCtx* DecompressContext()
+{
+	static ZSTD_DCtx* s_dctx = ZSTD_createDCtx();
+	return s_dctx;
+}
+
+const ZSTD_DDict* DecompressDictionary(mq::proto::charinfo::CompressionKind kind)
+{
+	static ZSTD_DDict* s_ddicts[kDictionaryKinds] = {};
+	const void* data = nullptr;
+	size_t size = 0;
+	if (!DictionaryFor(kind, &data, &size))
+		return nullptr;
+	if (!s_ddicts[kind])
+		s_ddicts[kind] = ZSTD_createDDict(data, size);
+	return s_ddicts[kind];
+}
+
+} // namespace
+
+bool CompressPayload(const std::string& in, std::string* out, mq::proto::charinfo::CompressionKind kind)
+{
+	const ZSTD_CDict* dictionary = CompressDictionary(kind);
+	if (!CompressContext() || !dictionary)
+		return false;
+
+	const auto start = std::chrono::steady_clock::now();
+	out->resize(ZSTD_compressBound(in.size()));
+	const size_t size = ZSTD_compress_usingCDict(CompressContext(), out->data(), out->size(),
+		in.data(), in.size(), dictionary);
+	s_stats.compress_ns += ElapsedNs(start);
+	if (ZSTD_isError(size) || size >= in.size()) {
+		s_stats.skipped++;
+		return false;
+	}
+
+	out->resize(size);
+	s_stats.compressed++;
+	s_stats.raw_bytes += in.size();
+	s_stats.compressed_bytes += size;
+	return true;
+}
+
+bool DecompressPayload(const std::string& in, std::string* out, mq::proto::charinfo::CompressionKind kind)
+{
+	const ZSTD_DDict* dictionary = DecompressDictionary(kind);
+	if (!DecompressContext() || !dictionary)
+		return false;
+
+	const auto start = std::chrono::steady_clock::now();
+	const unsigned long long declared = ZSTD_getFrameContentSize(in.data(), in.size());
+	if (declared == ZSTD_CONTENTSIZE_UNKNOWN || declared == ZSTD_CONTENTSIZE_ERROR
+		|| declared > kMaxDecompressedSize) {
+		s_stats.failures++;
+		return false;
+	}
+
+	out->resize(static_cast<size_t>(declared));
+	const size_t size = ZSTD_decompress_usingDDict(DecompressContext(), out->data(), out->size(),
+		in.data(), in.size(), dictionary);
+	s_stats.decompress_ns += ElapsedNs(start);
+	if (ZSTD_isError(size) || size != declared) {
+		s_stats.failures++;
+		return false;
+	}
+
+	s_stats.decompressed++;
+	return true;
+}
+
+CompressionStats& GetCompressionStats()
+{
+	return s_stats;
+}
+
+} // namespace charinfo
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "charinfo.pb.h"
+
+#include <cstdint>
+#include <string>
+
+namespace charinfo {
+
+// Counters for the optional payload compression, shown in the settings panel.
+struct CompressionStats {
+	uint64_t compressed = 0;       // messages sent compressed
+	uint64_t skipped = 0;          // compression attempted but did not shrink the payload
+	uint64_t raw_bytes = 0;        // input size of the compressed messages
+	uint64_t compressed_bytes = 0; // output size of the compressed messages
+	uint64_t compress_ns = 0;      // time spent compressing, including skipped attempts
+	uint64_t decompressed = 0;
+	uint64_t decompress_ns = 0;
+	uint64_t failures = 0;         // frames that failed to decompress
+};
+
+// Compress `in` into `out` as a zstd frame primed with the built-in dictionary of `kind`. Returns
+// false (leaving `out` unspecified) on error, for an unknown kind, or when the frame would not be
+// smaller than the input.
+bool CompressPayload(const std::string& in, std::string* out, mq::proto::charinfo::CompressionKind kind);
+
+// Inverse of CompressPayload. Rejects unknown kinds, and frames without a declared size or larger
+// than a sane bound.
+bool DecompressPayload(const std::string& in, std::string* out, mq::proto::charinfo::CompressionKind kind);
+
+CompressionStats& GetCompressionStats();
+
+} // namespace charinfo
@@ -0,0 +1,269 @@
+#pragma once
+
+// Generated by bench/train_dictionary.py from 4000 synthetic publishes (charinfo_samples); do not edit.
+// zstd --train --maxdict=4096 --dictID=2
+
+namespace charinfo {
+
+constexpr unsigned kTrainedDictionaryId = 2;
+
+const unsigned char kTrainedDictionary[] = {
+	0x37, 0xa4, 0x30, 0xec, 0x02, 0x00, 0x00, 0x00, 0x4e, 0x10, 0x20, 0xe5, 0xdd, 0x74, 0x3d, 0x8a,
+	0xd4, 0x70, 0xf6, 0x63, 0xc5, 0xcc, 0x74, 0x14, 0x59, 0x16, 0xf7, 0xf8, 0xfa, 0xbc, 0xbb, 0xbf,
+	0xb9, 0xd0, 0xdd, 0xe9, 0x4b, 0x6e, 0x0d, 0x1a, 0x25, 0xa2, 0x2d, 0xfd, 0xd7, 0x30, 0xf5, 0x8f,
+	0x62, 0x67, 0xc3, 0x36, 0xde, 0x79, 0xe7, 0x0c, 0x28, 0x15, 0x66, 0x82, 0xe7, 0x9b, 0x72, 0x5b,
+	0x59, 0xa7, 0xa0, 0xb5, 0x20, 0xf9, 0x45, 0x5d, 0x07, 0xab, 0xc2, 0xee, 0x8d, 0x93, 0x9a, 0x3e,
+	0x91, 0x5b, 0x4a, 0x29, 0xbb, 0x25, 0x75, 0xd3, 0x05, 0x00, 0x1c, 0x00, 0x00, 0x00, 0xc0, 0x40,
+	0x69, 0xd5, 0x0d, 0x00, 0x04, 0xa0, 0x48, 0xc8, 0x83, 0xc6, 0x85, 0x06, 0x40, 0x03, 0x43, 0x02,
+	0x04, 0x03, 0x41, 0xc5, 0xe1, 0x22, 0xd1, 0xa0, 0x24, 0x26, 0x87, 0x41, 0xa3, 0x40, 0x20, 0x08,
+	0x82, 0x82, 0x48, 0x8e, 0xa4, 0x40, 0x08, 0xcb, 0x34, 0xe5, 0x06, 0x00, 0x00, 0x00, 0xe4, 0x87,
+	0x8c, 0xc9, 0xa1, 0x13, 0x2a, 0x90, 0x29, 0x19, 0x80, 0xc3, 0x01, 0x00, 0x80, 0x21, 0x4c, 0x79,
+	0x6a, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00,
+	0x00, 0x03, 0x0c, 0x90, 0xa3, 0xb2, 0x02, 0x90, 0xa3, 0xb2, 0x02, 0x90, 0xa3, 0xb2, 0x02, 0xb2,
+	0x03, 0x12, 0x08, 0x85, 0x3f, 0x10, 0xcc, 0xc9, 0x01, 0x18, 0xf7, 0x05, 0x38, 0xbe, 0x10, 0x40,
+	0xc0, 0x96, 0xb1, 0x02, 0xba, 0x03, 0x09, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09,
+	0x08, 0x01, 0x12, 0xe0, 0x04, 0x0a, 0x0c, 0x6c, 0x69, 0x76, 0x65, 0x5f, 0x43, 0x61, 0x73, 0x70,
+	0x69, 0x61, 0x6e, 0x12, 0x07, 0x43, 0x61, 0x73, 0x70, 0x69, 0x61, 0x6e, 0x18, 0xad, 0x08, 0x20,
+	0x74, 0x2a, 0x12, 0x0a, 0x09, 0x45, 0x6e, 0x63, 0x68, 0x61, 0x6e, 0x74, 0x65, 0x72, 0x12, 0x03,
+	0x45, 0x4e, 0x43, 0x18, 0x0e, 0x30, 0x49, 0x38, 0x61, 0x42, 0x0b, 0x0a, 0x06, 0x4b, 0x61, 0x65,
+	0x6c, 0x65, 0x6e, 0x10, 0xed, 0x14, 0x48, 0x34, 0x52, 0x34, 0x0a, 0x0f, 0x54, 0x68, 0x65, 0x20,
+	0x47, 0x75, 0x69, 0x6c, 0x64, 0x20, 0x4c, 0x6f, 0x62, 0x62, 0x79, 0x12, 0x0a, 0x67, 0x75, 0x69,
+	0x6c, 0x64, 0x6c, 0x6f, 0x62, 0x62, 0x79, 0x18, 0xd8, 0x02, 0x2d, 0x00, 0x80, 0x9f, 0xc3, 0x35,
+	0x00, 0x48, 0xa1, 0x44, 0x3d, 0x00, 0x00, 0x18, 0xc2, 0x45, 0x00, 0x00, 0x71, 0x43, 0x5a, 0x04,
+	0x10, 0xa1, 0xbc, 0x02, 0x5a, 0x04, 0x10, 0xa4, 0xbe, 0x02, 0x5a, 0x04, 0x10, 0xaf, 0xb9, 0x02,
+	0x5a, 0x04, 0x10, 0xb2, 0xbb, 0x02, 0x5a, 0x04, 0x10, 0xb5, 0xbd, 0x02, 0x5a, 0x04, 0x10, 0xc0,
+	0xb8, 0x02, 0x5a, 0x04, 0x10, 0xc3, 0xba, 0x02, 0x5a, 0x04, 0x10, 0xc6, 0xbc, 0x02, 0x5a, 0x04,
+	0x10, 0xc9, 0xbe, 0x02, 0x5a, 0x04, 0x10, 0xd4, 0xb9, 0x02, 0x5a, 0x04, 0x10, 0xd7, 0xbb, 0x02,
+	0x5a, 0x04, 0x10, 0xda, 0xbd, 0x02, 0x5a, 0x04, 0x10, 0xe5, 0xb8, 0x02, 0x62, 0x1a, 0xa7, 0x04,
+	0xcf, 0x04, 0xf7, 0x04, 0x9f, 0x05, 0xc7, 0x05, 0xef, 0x05, 0x97, 0x06, 0xbf, 0x06, 0xe7, 0x06,
+	0x8f, 0x07, 0xb7, 0x07, 0xdf, 0x07, 0x87, 0x08, 0x6a, 0x04, 0x10, 0xc0, 0xb8, 0x02, 0x6a, 0x04,
+	0x10, 0xe5, 0xb8, 0x02, 0x6a, 0x04, 0x10, 0x8a, 0xb9, 0x02, 0x72, 0x03, 0x12, 0x12, 0x12, 0x88,
+	0x01, 0x1d, 0xc0, 0x01, 0xe0, 0xd4, 0x03, 0xc8, 0x01, 0xc7, 0xa1, 0x09, 0xd0, 0x01, 0x8d, 0xc2,
+	0x0c, 0xd8, 0x01, 0xb0, 0x8d, 0x07, 0xe0, 0x01, 0xc0, 0xa9, 0x07, 0xe8, 0x01, 0x90, 0xc5, 0x03,
+	0xf0, 0x01, 0x60, 0xad, 0x02, 0x10, 0x00, 0x00, 0x00, 0xd2, 0x02, 0x27, 0x9b, 0xe0, 0x02, 0xa6,
+	0xe0, 0x02, 0xb1, 0xe0, 0x02, 0xbc, 0xe0, 0x02, 0xc7, 0xe0, 0x02, 0xd2, 0xe0, 0x02, 0xdd, 0xe0,
+	0x02, 0xe8, 0xe0, 0x02, 0xf3, 0xe0, 0x02, 0xfe, 0xe0, 0x02, 0x89, 0xe1, 0x02, 0x94, 0xe1, 0x02,
+	0x9f, 0xe1, 0x02, 0xdd, 0x02, 0x9a, 0x99, 0x39, 0x40, 0xe2, 0x02, 0x12, 0x0d, 0x00, 0x00, 0x15,
+	0x42, 0x15, 0x00, 0x00, 0x48, 0x41, 0x20, 0xed, 0x46, 0x28, 0xc5, 0x46, 0x30, 0x28, 0xf2, 0x02,
+	0x12, 0x08, 0x01, 0x12, 0x0e, 0x6d, 0x75, 0x6c, 0x65, 0x61, 0x73, 0x73, 0x69, 0x73, 0x74, 0x2e,
+	0x6d, 0x61, 0x63, 0xfa, 0x02, 0x05, 0x00, 0x05, 0x07, 0x09, 0x0b, 0x82, 0x03, 0x68, 0x0a, 0x30,
+	0x08, 0x64, 0x12, 0x0a, 0x6c, 0x6f, 0x6f, 0x74, 0x6e, 0x73, 0x63, 0x6f, 0x6f, 0x74, 0x1a, 0x17,
+	0x6c, 0x75, 0x61, 0x2f, 0x6c, 0x6f, 0x6f, 0x74, 0x6e, 0x73, 0x63, 0x6f, 0x6f, 0x74, 0x2f, 0x69,
+	0x6e, 0x69, 0x74, 0x2e, 0x6c, 0x75, 0x61, 0x22, 0x07, 0x52, 0x55, 0x4e, 0x4e, 0x49, 0x4e, 0x47,
+	0x0a, 0x34, 0x08, 0x65, 0x12, 0x0c, 0x62, 0x75, 0x74, 0x74, 0x6f, 0x6e, 0x6d, 0x61, 0x73, 0x74,
+	0x65, 0x72, 0x1a, 0x19, 0x6c, 0x75, 0x61, 0x2f, 0x62, 0x75, 0x74, 0x74, 0x6f, 0x6e, 0x6d, 0x61,
+	0x73, 0x74, 0x65, 0x72, 0x2f, 0x69, 0x6e, 0x69, 0x74, 0x2e, 0x6c, 0x75, 0x61, 0x22, 0x07, 0x52,
+	0x55, 0x4e, 0x4e, 0x49, 0x4e, 0x47, 0x88, 0x03, 0xe4, 0xbc, 0xb1, 0x02, 0x92, 0x03, 0x34, 0xc0,
+	0x96, 0xb1, 0x02, 0x80, 0xcf, 0xb3, 0x02, 0xc0, 0x87, 0xb6, 0x02, 0x80, 0xc0, 0xb8, 0x02, 0xc0,
+	0xf8, 0xba, 0x02, 0x80, 0xb1, 0xbd, 0x02, 0xc0, 0xe9, 0xbf, 0x02, 0x80, 0xa2, 0xc2, 0x02, 0xc0,
+	0xda, 0xc4, 0x02, 0x80, 0x93, 0xc7, 0x02, 0xc0, 0xcb, 0xc9, 0x02, 0x80, 0x84, 0xcc, 0x02, 0xc0,
+	0xbc, 0xce, 0x02, 0x9a, 0x03, 0x0c, 0x90, 0xa3, 0xb2, 0x02, 0x90, 0xa3, 0xb2, 0x02, 0x90, 0xa3,
+	0xb2, 0x02, 0xb2, 0x03, 0x12, 0x08, 0xd5, 0x35, 0x10, 0xcc, 0xc9, 0x01, 0x18, 0xf7, 0x05, 0x38,
+	0xbe, 0x10, 0x40, 0xc0, 0x96, 0xb1, 0x02, 0xba, 0x03, 0x0b, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06,
+	0x07, 0x08, 0x09, 0x0a, 0x0b, 0x08, 0x01, 0x12, 0xfc, 0x04, 0x0a, 0x0d, 0x6c, 0x69, 0x76, 0x65,
+	0x5f, 0x4c, 0x79, 0x73, 0x61, 0x6e, 0x64, 0x72, 0x61, 0x12, 0x08, 0x4c, 0x79, 0x73, 0x61, 0x6e,
+	0x64, 0x72, 0x61, 0x18, 0xba, 0x0b, 0x20, 0x77, 0x2a, 0x14, 0x0a, 0x0b, 0x4e, 0x65, 0x63, 0x72,
+	0x6f, 0x6d, 0x61, 0x6e, 0x63, 0x65, 0x72, 0x12, 0x03, 0x4e, 0x45, 0x43, 0x18, 0x0b, 0x30, 0x5f,
+	0x38, 0x5b, 0x42, 0x18, 0x0a, 0x13, 0x61, 0x20, 0x66, 0x72, 0x6f, 0x73, 0x74, 0x20, 0x67, 0x69,
+	0x61, 0x6e, 0x74, 0x20, 0x73, 0x63, 0x6f, 0x75, 0x74, 0x10, 0x92, 0x10, 0x48, 0x3e, 0x52, 0x32,
+	0x0a, 0x0e, 0x45, 0x61, 0x73, 0x74, 0x65, 0x72, 0x6e, 0x20, 0x57, 0x61, 0x73, 0x74, 0x65, 0x73,
+	0x12, 0x0a, 0x65, 0x61, 0x73, 0x74, 0x77, 0x61, 0x73, 0x74, 0x65, 0x73, 0x18, 0x74, 0x2d, 0x00,
+	0x80, 0xa3, 0xc3, 0x35, 0x00, 0x48, 0xa1, 0x44, 0x3d, 0x00, 0x00, 0x18, 0xc2, 0x45, 0x00, 0x00,
+	0x13, 0x43, 0x5a, 0x04, 0x10, 0xb2, 0xbb, 0x02, 0x5a, 0x04, 0x10, 0xb5, 0xbd, 0x02, 0x5a, 0x04,
+	0x10, 0xc0, 0xb8, 0x02, 0x5a, 0x04, 0x10, 0xc3, 0xba, 0x02, 0x5a, 0x04, 0x10, 0xc6, 0xbc, 0x02,
+	0x5a, 0x04, 0x10, 0xc9, 0xbe, 0x02, 0x5a, 0x04, 0x10, 0xd4, 0xb9, 0x02, 0x5a, 0x04, 0x10, 0xd7,
+	0xbb, 0x02, 0x5a, 0x04, 0x10, 0xda, 0xbd, 0x02, 0x5a, 0x04, 0x10, 0xe5, 0xb8, 0x02, 0x5a, 0x04,
+	0x10, 0xe8, 0xba, 0x02, 0x5a, 0x04, 0x10, 0xeb, 0xbc, 0x02, 0x5a, 0x04, 0x10, 0xee, 0xbe, 0x02,
+	0x5a, 0x04, 0x10, 0xf9, 0xb9, 0x02, 0x5a, 0x04, 0x10, 0xfc, 0xbb, 0x02, 0x5a, 0x04, 0x10, 0xff,
+	0xbd, 0x02, 0x5a, 0x04, 0x10, 0x8a, 0xb9, 0x02, 0x5a, 0x04, 0x10, 0x8d, 0xbb, 0x02, 0x62, 0x24,
+	0xb1, 0x04, 0xd9, 0x04, 0x81, 0x05, 0xa9, 0x05, 0xd1, 0x05, 0xf9, 0x05, 0xa1, 0x06, 0xc9, 0x06,
+	0xf1, 0x06, 0x99, 0x07, 0xc1, 0x07, 0xe9, 0x07, 0x91, 0x08, 0xb9, 0x08, 0xe1, 0x08, 0x89, 0x09,
+	0xb1, 0x09, 0xd9, 0x09, 0x6a, 0x04, 0x10, 0xc9, 0xbe, 0x02, 0x6a, 0x04, 0x10, 0xee, 0xbe, 0x02,
+	0x6a, 0x04, 0x10, 0x93, 0xbf, 0x02, 0x72, 0x03, 0x12, 0x12, 0x12, 0x88, 0x01, 0x18, 0xc0, 0x01,
+	0xe0, 0xd4, 0x03, 0xc8, 0x01, 0xff, 0x9a, 0x0d, 0xd0, 0x01, 0xba, 0xe1, 0x0d, 0xd8, 0x01, 0x90,
+	0xd5, 0x06, 0xe0, 0x01, 0xc0, 0xa9, 0x07, 0xe8, 0x01, 0x90, 0xc5, 0x03, 0xf0, 0x01, 0x60, 0xad,
+	0x02, 0x10, 0x00, 0x00, 0x00, 0xc0, 0x02, 0xe4, 0xe0, 0x02, 0xd2, 0x02, 0x27, 0x9b, 0xe0, 0x02,
+	0xa6, 0x08, 0x01, 0x12, 0xd5, 0x04, 0x0a, 0x0d, 0x6c, 0x69, 0x76, 0x65, 0x5f, 0x4c, 0x79, 0x73,
+	0x61, 0x6e, 0x64, 0x72, 0x61, 0x12, 0x08, 0x4c, 0x79, 0x73, 0x61, 0x6e, 0x64, 0x72, 0x61, 0x18,
+	0xde, 0x18, 0x20, 0x77, 0x2a, 0x12, 0x0a, 0x09, 0x42, 0x65, 0x61, 0x73, 0x74, 0x6c, 0x6f, 0x72,
+	0x64, 0x12, 0x03, 0x42, 0x53, 0x54, 0x18, 0x0f, 0x30, 0x54, 0x38, 0x3b, 0x42, 0x15, 0x0a, 0x10,
+	0x61, 0x20, 0x74, 0x75, 0x6e, 0x64, 0x72, 0x61, 0x20, 0x6d, 0x61, 0x6d, 0x6d, 0x6f, 0x74, 0x68,
+	0x10, 0xda, 0x11, 0x48, 0x57, 0x52, 0x2b, 0x0a, 0x0a, 0x54, 0x68, 0x65, 0x20, 0x42, 0x61, 0x7a,
+	0x61, 0x61, 0x72, 0x12, 0x06, 0x62, 0x61, 0x7a, 0x61, 0x61, 0x72, 0x18, 0x97, 0x01, 0x2d, 0x00,
+	0xc0, 0xa9, 0xc3, 0x35, 0x00, 0x48, 0xa1, 0x44, 0x3d, 0x00, 0x00, 0x18, 0xc2, 0x45, 0x00, 0x00,
+	0x7f, 0x43, 0x5a, 0x04, 0x10, 0x9e, 0xba, 0x02, 0x5a, 0x04, 0x10, 0xa1, 0xbc, 0x02, 0x5a, 0x04,
+	0x10, 0xa4, 0xbe, 0x02, 0x5a, 0x04, 0x10, 0xaf, 0xb9, 0x02, 0x5a, 0x04, 0x10, 0xb2, 0xbb, 0x02,
+	0x5a, 0x04, 0x10, 0xb5, 0xbd, 0x02, 0x5a, 0x04, 0x10, 0xc0, 0xb8, 0x02, 0x5a, 0x04, 0x10, 0xc3,
+	0xba, 0x02, 0x5a, 0x04, 0x10, 0xc6, 0xbc, 0x02, 0x5a, 0x04, 0x10, 0xc9, 0xbe, 0x02, 0x5a, 0x04,
+	0x10, 0xd4, 0xb9, 0x02, 0x5a, 0x04, 0x10, 0xd7, 0xbb, 0x02, 0x5a, 0x04, 0x10, 0xda, 0xbd, 0x02,
+	0x5a, 0x04, 0x10, 0xe5, 0xb8, 0x02, 0x62, 0x1c, 0xca, 0x04, 0xf2, 0x04, 0x9a, 0x05, 0xc2, 0x05,
+	0xea, 0x05, 0x92, 0x06, 0xba, 0x06, 0xe2, 0x06, 0x8a, 0x07, 0xb2, 0x07, 0xda, 0x07, 0x82, 0x08,
+	0xaa, 0x08, 0xd2, 0x08, 0x6a, 0x04, 0x10, 0xb5, 0xbd, 0x02, 0x6a, 0x04, 0x10, 0xda, 0xbd, 0x02,
+	0x6a, 0x04, 0x10, 0xff, 0xbd, 0x02, 0x72, 0x03, 0x12, 0x12, 0x12, 0x88, 0x01, 0x1c, 0xc0, 0x01,
+	0xe0, 0xd4, 0x03, 0xc8, 0x01, 0xc3, 0xe4, 0x0b, 0xd0, 0x01, 0xde, 0xee, 0x0d, 0xd8, 0x01, 0x90,
+	0xa9, 0x04, 0xe0, 0x01, 0xc0, 0xa9, 0x07, 0xe8, 0x01, 0x90, 0xc5, 0x03, 0xf0, 0x01, 0x60, 0xad,
+	0x02, 0x10, 0x00, 0x00, 0x00, 0xd2, 0x02, 0x27, 0xf5, 0xdf, 0x02, 0x80, 0xe0, 0x02, 0x8b, 0xe0,
+	0x02, 0x96, 0xe0, 0x02, 0xa1, 0xe0, 0x02, 0xac, 0xe0, 0x02, 0xb7, 0xe0, 0x02, 0xc2, 0xe0, 0x02,
+	0xcd, 0xe0, 0x02, 0xd8, 0xe0, 0x02, 0xe3, 0xe0, 0x02, 0xee, 0xe0, 0x02, 0xf9, 0xe0, 0x02, 0xdd,
+	0x02, 0x9a, 0x99, 0x39, 0x40, 0xe2, 0x02, 0x12, 0x0d, 0x00, 0x00, 0x15, 0x42, 0x15, 0x00, 0x00,
+	0x48, 0x41, 0x20, 0xb6, 0x4f, 0x28, 0x8e, 0x4f, 0x30, 0x28, 0xf2, 0x02, 0x00, 0xfa, 0x02, 0x05,
+	0x00, 0x05, 0x07, 0x09, 0x0b, 0x82, 0x03, 0x60, 0x0a, 0x34, 0x08, 0x64, 0x12, 0x0c, 0x62, 0x75,
+	0x74, 0x74, 0x6f, 0x6e, 0x6d, 0x61, 0x73, 0x74, 0x65, 0x72, 0x1a, 0x19, 0x6c, 0x75, 0x61, 0x2f,
+	0x62, 0x75, 0x74, 0x74, 0x6f, 0x6e, 0x6d, 0x61, 0x73, 0x74, 0x65, 0x72, 0x2f, 0x69, 0x6e, 0x69,
+	0x74, 0x2e, 0x6c, 0x75, 0x61, 0x22, 0x07, 0x52, 0x55, 0x4e, 0x4e, 0x49, 0x4e, 0x47, 0x0a, 0x28,
+	0x08, 0x65, 0x12, 0x06, 0x65, 0x76, 0x65, 0x6e, 0x74, 0x73, 0x1a, 0x13, 0x6c, 0x75, 0x61, 0x2f,
+	0x65, 0x76, 0x65, 0x6e, 0x74, 0x73, 0x2f, 0x69, 0x6e, 0x69, 0x74, 0x2e, 0x6c, 0x75, 0x61, 0x22,
+	0x07, 0x52, 0x55, 0x4e, 0x4e, 0x49, 0x4e, 0x47, 0x88, 0x03, 0xb8, 0xa1, 0xb1, 0x02, 0x92, 0x03,
+	0x38, 0xc0, 0x96, 0xb1, 0x02, 0x80, 0xcf, 0xb3, 0x02, 0xc0, 0x87, 0xb6, 0x02, 0x80, 0xc0, 0xb8,
+	0x02, 0xc0, 0xf8, 0xba, 0x02, 0x80, 0xb1, 0xbd, 0x02, 0xc0, 0xe9, 0xbf, 0x02, 0x80, 0xa2, 0xc2,
+	0x02, 0xc0, 0xda, 0xc4, 0x02, 0x80, 0x93, 0xc7, 0x02, 0xc0, 0xcb, 0xc9, 0x02, 0x80, 0x84, 0xcc,
+	0x02, 0xc0, 0xbc, 0xce, 0x02, 0x80, 0xf5, 0xd0, 0x02, 0x9a, 0x03, 0x0c, 0x90, 0xa3, 0xb2, 0x02,
+	0x90, 0xa3, 0xb2, 0x02, 0x90, 0xa3, 0xb2, 0x02, 0xb2, 0x03, 0x12, 0x08, 0x91, 0x36, 0x10, 0xcc,
+	0xc9, 0x01, 0x18, 0xf7, 0x05, 0x38, 0xbe, 0x10, 0x40, 0xc0, 0x96, 0xb1, 0x02, 0xba, 0x03, 0x0b,
+	0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x08, 0x01, 0x12, 0xac, 0x05,
+	0x0a, 0x0b, 0x6c, 0x69, 0x76, 0x65, 0x5f, 0x44, 0x6f, 0x72, 0x77, 0x65, 0x6e, 0x12, 0x06, 0x44,
+	0x6f, 0x72, 0x77, 0x65, 0x6e, 0x18, 0xc1, 0x08, 0x20, 0x76, 0x2a, 0x0f, 0x0a, 0x06, 0x43, 0x6c,
+	0x65, 0x72, 0x69, 0x63, 0x12, 0x03, 0x43, 0x4c, 0x52, 0x18, 0x02, 0x30, 0x4f, 0x38, 0x3d, 0x42,
+	0x18, 0x0a, 0x13, 0x61, 0x20, 0x66, 0x72, 0x6f, 0x73, 0x74, 0x20, 0x67, 0x69, 0x61, 0x6e, 0x74,
+	0x20, 0x73, 0x63, 0x6f, 0x75, 0x74, 0x10, 0xb9, 0x13, 0x48, 0x3b, 0x52, 0x37, 0x0a, 0x11, 0x44,
+	0x72, 0x61, 0x67, 0x6f, 0x6e, 0x73, 0x63, 0x61, 0x6c, 0x65, 0x20, 0x48, 0x69, 0x6c, 0x6c, 0x73,
+	0x12, 0x0b, 0x64, 0x72, 0x61, 0x67, 0x6f, 0x6e, 0x73, 0x63, 0x61, 0x6c, 0x65, 0x18, 0xba, 0x03,
+	0x2d, 0x00, 0x40, 0x97, 0xc3, 0x35, 0x00, 0x48, 0xa1, 0x44, 0x3d, 0x00, 0x00, 0x18, 0xc2, 0x45,
+	0x00, 0x80, 0x8f, 0x43, 0x5a, 0x04, 0x10, 0xe5, 0xb8, 0x02, 0x5a, 0x04, 0x10, 0xe8, 0xba, 0x02,
+	0x5a, 0x04, 0x10, 0xeb, 0xbc, 0x02, 0x5a, 0x04, 0x10, 0xee, 0xbe, 0x02, 0x5a, 0x04, 0x10, 0xf9,
+	0xb9, 0x02, 0x5a, 0x04, 0x10, 0xfc, 0xbb, 0x02, 0x5a, 0x04, 0x10, 0xff, 0xbd, 0x02, 0x5a, 0x04,
+	0x10, 0x8a, 0xb9, 0x02, 0x5a, 0x04, 0x10, 0x8d, 0xbb, 0x02, 0x5a, 0x04, 0x10, 0x90, 0xbd, 0x02,
+	0x5a, 0x04, 0x10, 0x93, 0xbf, 0x02, 0x5a, 0x04, 0x10, 0x9e, 0xba, 0x02, 0x5a, 0x04, 0x10, 0xa1,
+	0xbc, 0x02, 0x5a, 0x04, 0x10, 0xa4, 0xbe, 0x02, 0x5a, 0x04, 0x10, 0xaf, 0xb9, 0x02, 0x5a, 0x04,
+	0x10, 0xb2, 0xbb, 0x02, 0x5a, 0x04, 0x10, 0xb5, 0xbd, 0x02, 0x5a, 0x04, 0x10, 0xc0, 0xb8, 0x02,
+	0x62, 0x24, 0xae, 0x04, 0xd6, 0x04, 0xfe, 0x04, 0xa6, 0x05, 0xce, 0x05, 0xf6, 0x05, 0x9e, 0x06,
+	0xc6, 0x06, 0xee, 0x06, 0x96, 0x07, 0xbe, 0x07, 0xe6, 0x07, 0x8e, 0x08, 0xb6, 0x08, 0xde, 0x08,
+	0x86, 0x09, 0xae, 0x09, 0xd6, 0x09, 0x6a, 0x04, 0x10, 0xfc, 0xbb, 0x02, 0x6a, 0x04, 0x10, 0xa1,
+	0xbc, 0x02, 0x6a, 0x04, 0x10, 0xc6, 0xbc, 0x02, 0x72, 0x03, 0x12, 0x12, 0x12, 0x88, 0x01, 0x18,
+	0xc0, 0x01, 0xe0, 0xd4, 0x03, 0xc8, 0x01, 0xe7, 0x84, 0x09, 0xd0, 0x01, 0x81, 0xa6, 0x0b, 0xd8,
+	0x01, 0xf0, 0xbb, 0x04, 0xe0, 0x01, 0xc0, 0xa9, 0x07, 0xe8, 0x01, 0x90, 0xc5, 0x03, 0xf0, 0x01,
+	0x60, 0xad, 0x02, 0x10, 0x00, 0x00, 0x00, 0xc0, 0x02, 0xdc, 0xdf, 0x02, 0xd2, 0x02, 0x27, 0x9e,
+	0xe0, 0x02, 0xa9, 0xe0, 0x02, 0xb4, 0xe0, 0x02, 0xbf, 0xe0, 0x02, 0xca, 0xe0, 0x02, 0xd5, 0xe0,
+	0x02, 0xe0, 0xe0, 0x02, 0xeb, 0xe0, 0x02, 0xf6, 0xe0, 0x02, 0x81, 0xe1, 0x02, 0x8c, 0xe1, 0x02,
+	0x97, 0xe1, 0x02, 0xa2, 0xe1, 0x02, 0xdd, 0x02, 0x9a, 0x99, 0x39, 0x40, 0xe2, 0x02, 0x12, 0x0d,
+	0x00, 0x00, 0x15, 0x42, 0x15, 0x00, 0x00, 0x48, 0x41, 0x20, 0xe9, 0x4e, 0x28, 0xc1, 0x4e, 0x30,
+	0x28, 0x3f, 0x30, 0x28, 0xf2, 0x02, 0x00, 0xfa, 0x02, 0x05, 0x00, 0x05, 0x07, 0x09, 0x0b, 0x82,
+	0x03, 0x32, 0x0a, 0x30, 0x08, 0x64, 0x12, 0x0a, 0x6c, 0x6f, 0x6f, 0x74, 0x6e, 0x73, 0x63, 0x6f,
+	0x6f, 0x74, 0x1a, 0x17, 0x6c, 0x75, 0x61, 0x2f, 0x6c, 0x6f, 0x6f, 0x74, 0x6e, 0x73, 0x63, 0x6f,
+	0x6f, 0x74, 0x2f, 0x69, 0x6e, 0x69, 0x74, 0x2e, 0x6c, 0x75, 0x61, 0x22, 0x07, 0x52, 0x55, 0x4e,
+	0x4e, 0x49, 0x4e, 0x47, 0x88, 0x03, 0x98, 0x9b, 0xb1, 0x02, 0x92, 0x03, 0x60, 0xc0, 0x96, 0xb1,
+	0x02, 0x80, 0xcf, 0xb3, 0x02, 0xc0, 0x87, 0xb6, 0x02, 0x80, 0xc0, 0xb8, 0x02, 0xc0, 0xf8, 0xba,
+	0x02, 0x80, 0xb1, 0xbd, 0x02, 0xc0, 0xe9, 0xbf, 0x02, 0x80, 0xa2, 0xc2, 0x02, 0xc0, 0xda, 0xc4,
+	0x02, 0x80, 0x93, 0xc7, 0x02, 0xc0, 0xcb, 0xc9, 0x02, 0x80, 0x84, 0xcc, 0x02, 0xc0, 0xbc, 0xce,
+	0x02, 0x80, 0xf5, 0xd0, 0x02, 0xc0, 0xad, 0xd3, 0x02, 0x80, 0xe6, 0xd5, 0x02, 0xc0, 0x9e, 0xd8,
+	0x02, 0x80, 0xd7, 0xda, 0x02, 0xc0, 0x8f, 0xdd, 0x02, 0x80, 0xc8, 0xdf, 0x02, 0xc0, 0x80, 0xe2,
+	0x02, 0x80, 0xb9, 0xe4, 0x02, 0xc0, 0xf1, 0xe6, 0x02, 0x80, 0xaa, 0xe9, 0x02, 0x9a, 0x03, 0x0c,
+	0x90, 0xa3, 0xb2, 0x02, 0x90, 0xa3, 0xb2, 0x02, 0x90, 0xa3, 0xb2, 0x02, 0xb2, 0x03, 0x12, 0x08,
+	0x85, 0x35, 0x10, 0xcc, 0xc9, 0x01, 0x18, 0xf7, 0x05, 0x38, 0xbe, 0x10, 0x40, 0xc0, 0x96, 0xb1,
+	0x02, 0xba, 0x03, 0x09, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x08, 0x01, 0x12,
+	0xb3, 0x05, 0x0a, 0x0d, 0x6c, 0x69, 0x76, 0x65, 0x5f, 0x42, 0x72, 0x75, 0x6e, 0x68, 0x69, 0x6c,
+	0x64, 0x12, 0x08, 0x42, 0x72, 0x75, 0x6e, 0x68, 0x69, 0x6c, 0x64, 0x18, 0xec, 0x12, 0x20, 0x7c,
+	0x2a, 0x11, 0x0a, 0x08, 0x4d, 0x61, 0x67, 0x69, 0x63, 0x69, 0x61, 0x6e, 0x12, 0x03, 0x4d, 0x41,
+	0x47, 0x18, 0x0d, 0x30, 0x61, 0x38, 0x3f, 0x42, 0x17, 0x0a, 0x12, 0x61, 0x20, 0x72, 0x65, 0x73,
+	0x74, 0x6c, 0x65, 0x73, 0x73, 0x20, 0x64, 0x65, 0x72, 0x76, 0x69, 0x73, 0x68, 0x10, 0xdc, 0x0f,
+	0x48, 0x5d, 0x52, 0x3c, 0x0a, 0x14, 0x50, 0x6c, 0x61, 0x6e, 0x65, 0x20, 0x6f, 0x66, 0x20, 0x54,
+	0x72, 0x61, 0x6e, 0x71, 0x75, 0x69, 0x6c, 0x69, 0x74, 0x79, 0x12, 0x0d, 0x70, 0x6f, 0x74, 0x72,
+	0x61, 0x6e, 0x71, 0x75, 0x69, 0x6c, 0x69, 0x74, 0x79, 0x18, 0xcb, 0x01, 0x2d, 0x00, 0x40, 0xc6,
+	0xc3, 0x35, 0x00, 0x48, 0xa1, 0x44, 0x3d, 0x00, 0x00, 0x18, 0xc2, 0x45, 0x00, 0x00, 0xf0, 0x41,
+	0x5a, 0x04, 0x10, 0xd4, 0xb9, 0x02, 0x5a, 0x04, 0x10, 0xd7, 0xbb, 0x02, 0x5a, 0x04, 0x10, 0xda,
+	0xbd, 0x02, 0x5a, 0x04, 0x10, 0xe5, 0xb8, 0x02, 0x5a, 0x04, 0x10, 0xe8, 0xba, 0x02, 0x5a, 0x04,
+	0x10, 0xeb, 0xbc, 0x02, 0x5a, 0x04, 0x10, 0xee, 0xbe, 0x02, 0x5a, 0x04, 0x10, 0xf9, 0xb9, 0x02,
+	0x5a, 0x04, 0x10, 0xfc, 0xbb, 0x02, 0x5a, 0x04, 0x10, 0xff, 0xbd, 0x02, 0x5a, 0x04, 0x10, 0x8a,
+	0xb9, 0x02, 0x5a, 0x04, 0x10, 0x8d, 0xbb, 0x02, 0x5a, 0x04, 0x10, 0x90, 0xbd, 0x02, 0x5a, 0x04,
+	0x10, 0x93, 0xbf, 0x02, 0x5a, 0x04, 0x10, 0x9e, 0xba, 0x02, 0x5a, 0x04, 0x10, 0xa1, 0xbc, 0x02,
+	0x5a, 0x04, 0x10, 0xa4, 0xbe, 0x02, 0x5a, 0x04, 0x10, 0xaf, 0xb9, 0x02, 0x5a, 0x04, 0x10, 0xb2,
+	0xbb, 0x02, 0x62, 0x26, 0xd0, 0x04, 0xf8, 0x04, 0xa0, 0x05, 0xc8, 0x05, 0xf0, 0x05, 0x98, 0x06,
+	0xc0, 0x06, 0xe8, 0x06, 0x90, 0x07, 0xb8, 0x07, 0xe0, 0x07, 0x88, 0x08, 0xb0, 0x08, 0xd8, 0x08,
+	0x80, 0x09, 0xa8, 0x09, 0xd0, 0x09, 0xf8, 0x09, 0xa0, 0x0a, 0x6a, 0x04, 0x10, 0xeb, 0xbc, 0x02,
+	0x6a, 0x04, 0x10, 0x90, 0xbd, 0x02, 0x6a, 0x04, 0x10, 0xb5, 0xbd, 0x02, 0x72, 0x03, 0x12, 0x12,
+	0x12, 0x88, 0x01, 0x17, 0xc0, 0x01, 0xe0, 0xd4, 0x03, 0xc8, 0x01, 0xf3, 0xf8, 0x0c, 0xd0, 0x01,
+	0xdc, 0x9a, 0x0d, 0xd8, 0x01, 0xd0, 0xce, 0x04, 0xe0, 0x01, 0xc0, 0xa9, 0x07, 0xe8, 0x01, 0x90,
+	0xc5, 0x03, 0xf0, 0x01, 0x60, 0xad, 0x02, 0x10, 0x00, 0x00, 0x00, 0xd2, 0x02, 0x27, 0xdf, 0xe0,
+	0x02, 0xea, 0xe0, 0x02, 0xf5, 0xe0, 0x02, 0x80, 0xe1, 0x02, 0x8b, 0xe1, 0x02, 0x96, 0xe1, 0x02,
+	0xa1, 0xe1, 0x02, 0xac, 0xe1, 0x02, 0xb7, 0xe1, 0x02, 0xc2, 0xe1, 0x02, 0xcd, 0xe1, 0x02, 0xd8,
+	0xe1, 0x02, 0xe3, 0xe1, 0x02, 0xdd, 0x02, 0x9a, 0x99, 0x39, 0x40, 0xe2, 0x02, 0x12, 0x0d, 0x00,
+	0x00, 0x15, 0x42, 0x15, 0x00, 0x00, 0x48, 0x41, 0x20, 0xdc, 0x41, 0x28, 0xb4, 0x41, 0x30, 0x28,
+	0xf2, 0x02, 0x12, 0x08, 0x01, 0x12, 0x0e, 0x61, 0x75, 0x74, 0x6f, 0x63, 0x6c, 0x65, 0x72, 0x69,
+	0x63, 0x2e, 0x6d, 0x61, 0x63, 0xfa, 0x02, 0x05, 0x00, 0x05, 0x07, 0x09, 0x0b, 0x82, 0x03, 0x5e,
+	0x0a, 0x2a, 0x08, 0x64, 0x12, 0x07, 0x72, 0x67, 0x6d, 0x65, 0x72, 0x63, 0x73, 0x1a, 0x14, 0x6c,
+	0x75, 0x61, 0x2f, 0x72, 0x67, 0x6d, 0x65, 0x72, 0x63, 0x73, 0x2f, 0x69, 0x6e, 0x69, 0x74, 0x2e,
+	0x6c, 0x75, 0x61, 0x22, 0x07, 0x52, 0x55, 0x4e, 0x4e, 0x49, 0x4e, 0x47, 0x0a, 0x30, 0x08, 0x65,
+	0x12, 0x0a, 0x6c, 0x6f, 0x6f, 0x74, 0x6e, 0x73, 0x63, 0x6f, 0x6f, 0x74, 0x1a, 0x17, 0x6c, 0x75,
+	0x61, 0x2f, 0x6c, 0x6f, 0x6f, 0x74, 0x6e, 0x73, 0x63, 0x6f, 0x6f, 0x74, 0x2f, 0x69, 0x6e, 0x69,
+	0x74, 0x2e, 0x6c, 0x75, 0x61, 0x22, 0x07, 0x52, 0x55, 0x4e, 0x4e, 0x49, 0x4e, 0x47, 0x88, 0x03,
+	0xe0, 0x9c, 0xb1, 0x02, 0x92, 0x03, 0x4c, 0xc0, 0x96, 0xb1, 0x02, 0x80, 0xcf, 0xb3, 0x02, 0xc0,
+	0x87, 0xb6, 0x02, 0x80, 0xc0, 0xb8, 0x02, 0xc0, 0xf8, 0xba, 0x02, 0x80, 0xb1, 0xbd, 0x02, 0xc0,
+	0xe9, 0xbf, 0x02, 0x80, 0xa2, 0xc2, 0x02, 0xc0, 0xda, 0xc4, 0x02, 0x80, 0x93, 0xc7, 0x02, 0xc0,
+	0xcb, 0xc9, 0x02, 0x80, 0x84, 0xcc, 0x02, 0xc0, 0xbc, 0xce, 0x02, 0x80, 0xf5, 0xd0, 0x02, 0xc0,
+	0xad, 0xd3, 0x02, 0x80, 0xe6, 0xd5, 0x02, 0xc0, 0x9e, 0xd8, 0x02, 0x80, 0xd7, 0xda, 0x02, 0xc0,
+	0x8f, 0xdd, 0x02, 0x9a, 0x03, 0x0c, 0x90, 0xa3, 0xb2, 0x02, 0x90, 0xa3, 0xb2, 0x02, 0x90, 0xa3,
+	0xb2, 0x02, 0xb2, 0x03, 0x12, 0x08, 0xc9, 0x3e, 0x10, 0xcc, 0xc9, 0x01, 0x18, 0xf7, 0x05, 0x38,
+	0xbe, 0x10, 0x40, 0xc0, 0x96, 0xb1, 0x02, 0xba, 0x03, 0x0b, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06,
+	0x07, 0x08, 0x09, 0x0a, 0x0b, 0x08, 0x01, 0x12, 0x9a, 0x05, 0x0a, 0x0c, 0x6c, 0x69, 0x76, 0x65,
+	0x5f, 0x45, 0x6c, 0x73, 0x70, 0x65, 0x74, 0x68, 0x12, 0x07, 0x45, 0x6c, 0x73, 0x70, 0x65, 0x74,
+	0x68, 0x18, 0xc0, 0x0f, 0x20, 0x79, 0x2a, 0x0e, 0x0a, 0x05, 0x52, 0x6f, 0x67, 0x75, 0x65, 0x12,
+	0x03, 0x52, 0x4f, 0x47, 0x18, 0x09, 0x30, 0x48, 0x42, 0x0f, 0x0a, 0x0a, 0x4c, 0x6f, 0x72, 0x64,
+	0x20, 0x56, 0x79, 0x65, 0x6d, 0x6d, 0x10, 0xfc, 0x14, 0x48, 0x61, 0x52, 0x3c, 0x0a, 0x16, 0x54,
+	0x68, 0x65, 0x20, 0x50, 0x6c, 0x61, 0x6e, 0x65, 0x20, 0x6f, 0x66, 0x20, 0x4b, 0x6e, 0x6f, 0x77,
+	0x6c, 0x65, 0x64, 0x67, 0x65, 0x12, 0x0b, 0x70, 0x6f, 0x6b, 0x6e, 0x6f, 0x77, 0x6c, 0x65, 0x64,
+	0x67, 0x09, 0x97, 0x0a, 0xbf, 0x0a, 0xe7, 0x0a, 0x6a, 0x04, 0x10, 0xc3, 0xba, 0x02, 0x6a, 0x04,
+	0x10, 0xe8, 0xba, 0x02, 0x6a, 0x04, 0x10, 0x8d, 0xbb, 0x02, 0x72, 0x03, 0x12, 0x12, 0x12, 0x88,
+	0x01, 0x15, 0xc0, 0x01, 0xe0, 0xd4, 0x03, 0xc8, 0x01, 0xf3, 0xc4, 0x07, 0xd0, 0x01, 0x94, 0xa0,
+	0x0b, 0xd8, 0x01, 0xa0, 0xa6, 0x06, 0xe0, 0x01, 0xc0, 0xa9, 0x07, 0xe8, 0x01, 0x90, 0xc5, 0x03,
+	0xf0, 0x01, 0x60, 0xad, 0x02, 0x10, 0x00, 0x00, 0x00, 0xd2, 0x02, 0x27, 0xd6, 0xe0, 0x02, 0xe1,
+	0xe0, 0x02, 0xec, 0xe0, 0x02, 0xf7, 0xe0, 0x02, 0x82, 0xe1, 0x02, 0x8d, 0xe1, 0x02, 0x98, 0xe1,
+	0x02, 0xa3, 0xe1, 0x02, 0xae, 0xe1, 0x02, 0xb9, 0xe1, 0x02, 0xc4, 0xe1, 0x02, 0xcf, 0xe1, 0x02,
+	0xda, 0xe1, 0x02, 0xdd, 0x02, 0x9a, 0x99, 0x39, 0x40, 0xe2, 0x02, 0x12, 0x0d, 0x00, 0x00, 0x15,
+	0x42, 0x15, 0x00, 0x00, 0x48, 0x41, 0x20, 0xfc, 0x48, 0x28, 0xd4, 0x48, 0x30, 0x28, 0xf2, 0x02,
+	0x12, 0x08, 0x01, 0x12, 0x0e, 0x6b, 0x69, 0x73, 0x73, 0x61, 0x73, 0x73, 0x69, 0x73, 0x74, 0x2e,
+	0x6d, 0x61, 0x63, 0xfa, 0x02, 0x05, 0x00, 0x05, 0x07, 0x09, 0x0b, 0x82, 0x03, 0x94, 0x01, 0x0a,
+	0x2a, 0x08, 0x64, 0x12, 0x07, 0x72, 0x67, 0x6d, 0x65, 0x72, 0x63, 0x73, 0x1a, 0x14, 0x6c, 0x75,
+	0x61, 0x2f, 0x72, 0x67, 0x6d, 0x65, 0x72, 0x63, 0x73, 0x2f, 0x69, 0x6e, 0x69, 0x74, 0x2e, 0x6c,
+	0x75, 0x61, 0x22, 0x07, 0x52, 0x55, 0x4e, 0x4e, 0x49, 0x4e, 0x47, 0x0a, 0x30, 0x08, 0x65, 0x12,
+	0x0a, 0x6c, 0x6f, 0x6f, 0x74, 0x6e, 0x73, 0x63, 0x6f, 0x6f, 0x74, 0x1a, 0x17, 0x6c, 0x75, 0x61,
+	0x2f, 0x6c, 0x6f, 0x6f, 0x74, 0x6e, 0x73, 0x63, 0x6f, 0x6f, 0x74, 0x2f, 0x69, 0x6e, 0x69, 0x74,
+	0x2e, 0x6c, 0x75, 0x61, 0x22, 0x07, 0x52, 0x55, 0x4e, 0x4e, 0x49, 0x4e, 0x47, 0x0a, 0x34, 0x08,
+	0x66, 0x12, 0x0c, 0x62, 0x75, 0x74, 0x74, 0x6f, 0x6e, 0x6d, 0x61, 0x73, 0x74, 0x65, 0x72, 0x1a,
+	0x19, 0x6c, 0x75, 0x61, 0x2f, 0x62, 0x75, 0x74, 0x74, 0x6f, 0x6e, 0x6d, 0x61, 0x73, 0x74, 0x65,
+	0x72, 0x2f, 0x69, 0x6e, 0x69, 0x74, 0x2e, 0x6c, 0x75, 0x61, 0x22, 0x07, 0x52, 0x55, 0x4e, 0x4e,
+	0x49, 0x4e, 0x47, 0x88, 0x03, 0xe4, 0xa3, 0xb1, 0x02, 0x92, 0x03, 0x54, 0xc0, 0x96, 0xb1, 0x02,
+	0x80, 0xcf, 0xb3, 0x02, 0xc0, 0x87, 0xb6, 0x02, 0x80, 0xc0, 0xb8, 0x02, 0xc0, 0xf8, 0xba, 0x02,
+	0x80, 0xb1, 0xbd, 0x02, 0xc0, 0xe9, 0xbf, 0x02, 0x80, 0xa2, 0xc2, 0x02, 0xc0, 0xda, 0xc4, 0x02,
+	0x80, 0x93, 0xc7, 0x02, 0xc0, 0xcb, 0xc9, 0x02, 0x80, 0x84, 0xcc, 0x02, 0xc0, 0xbc, 0xce, 0x02,
+	0x80, 0xf5, 0xd0, 0x02, 0xc0, 0xad, 0xd3, 0x02, 0x80, 0xe6, 0xd5, 0x02, 0xc0, 0x9e, 0xd8, 0x02,
+	0x80, 0xd7, 0xda, 0x02, 0xc0, 0x8f, 0xdd, 0x02, 0x80, 0xc8, 0xdf, 0x02, 0xc0, 0x80, 0xe2, 0x02,
+	0x9a, 0x03, 0x0c, 0x90, 0xa3, 0xb2, 0x02, 0x90, 0xa3, 0xb2, 0x02, 0x90, 0xa3, 0xb2, 0x02, 0xb2,
+	0x03, 0x12, 0x08, 0x99, 0x3a, 0x10, 0xcc, 0xc9, 0x01, 0x18, 0xf7, 0x05, 0x38, 0xbe, 0x10, 0x40,
+	0xc0, 0x96, 0xb1, 0x02, 0xba, 0x03, 0x0d, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09,
+	0x0a, 0x0b, 0x0c, 0x0d, 0x08, 0x01, 0x12, 0x98, 0x06, 0x0a, 0x0d, 0x6c, 0x69, 0x76, 0x65, 0x5f,
+	0x47, 0x61, 0x6c, 0x61, 0x64, 0x72, 0x65, 0x6c, 0x12, 0x08, 0x47, 0x61, 0x6c, 0x61, 0x64, 0x72,
+	0x65, 0x6c, 0x18, 0xbb, 0x2c, 0x20, 0x7a, 0x2a, 0x0f, 0x0a, 0x06, 0x57, 0x69, 0x7a, 0x61, 0x72,
+	0x64, 0x12, 0x03, 0x57, 0x49, 0x5a, 0x18, 0x0c, 0x30, 0x5b, 0x38, 0x53, 0x42, 0x15, 0x0a, 0x10,
+	0x61, 0x20, 0x74, 0x75, 0x6e, 0x64, 0x72, 0x61, 0x20, 0x6d, 0x61, 0x6d, 0x6d, 0x6f, 0x74, 0x68,
+	0x10, 0xf3, 0x11, 0x48, 0x39, 0x52, 0x37, 0x0a, 0x0f, 0x53, 0x68, 0x61, 0x72, 0x64, 0x27, 0x73,
+	0x20, 0x4c, 0x61, 0x6e, 0x64, 0x69, 0x6e, 0x67, 0x12, 0x0d, 0x73, 0x68, 0x61, 0x72, 0x64, 0x73,
+	0x6c, 0x61, 0x6e, 0x64, 0x69, 0x6e, 0x67, 0x18, 0xf0, 0x05, 0x2d, 0x00, 0xc0, 0x95, 0xc3, 0x35,
+	0x00, 0x48, 0xa1, 0x44, 0x3d, 0x00, 0x00, 0x18, 0xc2, 0x45, 0x00, 0x00, 0xfb, 0x43, 0x5a, 0x04,
+	0x10, 0xd7, 0xbb, 0x02, 0x5a, 0x04, 0x10, 0xda, 0xbd, 0x02, 0x5a, 0x04, 0x10, 0xe5, 0xb8, 0x02,
+	0x5a, 0x04, 0x10, 0xe8, 0xba, 0x02, 0x5a, 0x04, 0x10, 0xeb, 0xbc, 0x02, 0x5a, 0x04, 0x10, 0xee,
+	0xbe, 0x02, 0x5a, 0x04, 0x10, 0xf9, 0xb9, 0x02, 0x5a, 0x04, 0x10, 0xfc, 0xbb, 0x02, 0x5a, 0x04,
+	0x10, 0xff, 0xbd, 0x02, 0x5a, 0x04, 0x10, 0x8a, 0xb9, 0x02, 0x5a, 0x04, 0x10, 0x8d, 0xbb, 0x02,
+	0x5a, 0x04, 0x10, 0x90, 0xbd, 0x02, 0x5a, 0x04, 0x10, 0x93, 0xbf, 0x02, 0x5a, 0x04, 0x10, 0x9e,
+	0xba, 0x02, 0x5a, 0x04, 0x10, 0xa1, 0xbc, 0x02, 0x5a, 0x04, 0x10, 0xa4, 0xbe, 0x02, 0x5a, 0x04,
+	0x10, 0xaf, 0xb9, 0x02, 0x5a, 0x04, 0x10, 0xb2, 0xbb, 0x02, 0x5a, 0x04, 0x10, 0xb5, 0xbd, 0x02,
+	0x5a, 0x04, 0x10, 0xc0, 0xb8, 0x02, 0x5a, 0x04, 0x10, 0xc3, 0xba, 0x02, 0x5a, 0x04, 0x10, 0xc6,
+	0xbc, 0x02, 0x5a, 0x04, 0x10, 0xc9, 0xbe, 0x02, 0x5a, 0x04, 0x10, 0xd4, 0xb9, 0x02, 0x62, 0x30,
+	0xac, 0x04, 0xd4, 0x04, 0xfc, 0x04, 0xa4, 0x05, 0xcc, 0x05, 0xf4, 0x05, 0x9c, 0x06, 0xc4, 0x06,
+	0xec, 0x06, 0x94, 0x07, 0xbc, 0x07, 0xe4, 0x07, 0x8c, 0x08, 0xb4, 0x08, 0xdc, 0x08, 0x84, 0x09,
+	0xac, 0x09, 0xd4, 0x09, 0xfc, 0x09, 0xa4, 0x0a, 0xcc, 0x0a, 0xf4, 0x0a, 0x9c, 0x0b, 0xc4, 0x0b,
+	0x6a, 0x04, 0x10, 0xee, 0xbe, 0x02, 0x6a, 0x04, 0x10, 0x93, 0xbf, 0x02, 0x6a, 0x04, 0x10, 0xc0,
+	0xb8, 0x02, 0x72, 0x03, 0x12, 0x12, 0x12, 0x88, 0x01, 0x12, 0xc0, 0x01, 0xe0, 0xd4, 0x03, 0xc8,
+	0x01, 0xf3, 0xf2, 0x0c, 0xd0, 0x01, 0xbb, 0x82, 0x0e, 0xd8, 0x01, 0x90, 0x8a, 0x06, 0xe0, 0x01,
+};
+
+} // namespace charinfo
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace charinfo {
+
+// Joined replies: the first joiner queued starts a delay of kJoinReplyMinDelayMs plus a random
+// 0..kJoinReplyJitterMs, and everyone who joined by then is answered together.
+constexpr int64_t kJoinReplyMinDelayMs = 50;
+constexpr int64_t kJoinReplyJitterMs = 450;
+
+// Whether `joiners` queued joiners that need our full snapshot, out of `peers` known peers, are
+// answered with one broadcast (most of the group joined, e.g. a raid zoning in) rather than a
+// publish addressed to each.
+inline bool BroadcastJoinReplies(size_t joiners, size_t peers)
+{
+	return joiners * 2 > peers;
+}
+
+} // namespace charinfo
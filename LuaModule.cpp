@@ -1,6 +1,6 @@
 /*
  * Lua module for MQCharinfo: require("plugin.charinfo")
- * Exposes GetInfo, GetPeers, GetPeerCnt. Peer table from GetInfo includes Stacks/StacksPet.
+ * Exposes GetInfo, GetPeers, GetPeerCnt (optionally for one channel). Peer table from GetInfo includes Stacks/StacksPet.
  * Peer data is bound as usertypes (CharinfoPeer) so Lua reads from C++ without table copies.
  *
  * IMPORTANT (do not change without testing require("plugin.charinfo") and the loader):
@@ -26,11 +26,18 @@ using namespace mq::proto::charinfo;
 
 namespace {
 
+using charinfo::PublishSection;
+using charinfo::SectionBit;
+
+// Every CharinfoPeer property records a read of the sections it is published in; the union of
+// recent reads is this client's subscription.
+
 // Helper for CharinfoPeer field properties: nil if invalidated, otherwise returns the field value.
 template <typename MemberT>
-auto MakePeerFieldProperty(MemberT charinfo::CharinfoPeer::* member)
+auto MakePeerFieldProperty(MemberT charinfo::CharinfoPeer::* member, charinfo::SectionMask sections)
 {
-	return sol::property([member](const charinfo::CharinfoPeer& peer, sol::this_state L) {
+	return sol::property([member, sections](const charinfo::CharinfoPeer& peer, sol::this_state L) {
+		charinfo::NoteSectionRead(sections);
 		if (peer.invalidated())
 			return sol::make_object(L, sol::lua_nil);
 		return sol::make_object(L, peer.*member);
@@ -39,9 +46,10 @@ auto MakePeerFieldProperty(MemberT charinfo::CharinfoPeer::* member)
 
 // Helper for CharinfoPeer container properties exposed as Lua arrays (1-based indices).
 template <typename ContainerMember>
-auto MakePeerTableProperty(ContainerMember charinfo::CharinfoPeer::* member)
+auto MakePeerTableProperty(ContainerMember charinfo::CharinfoPeer::* member, charinfo::SectionMask sections)
 {
-	return sol::property([member](const charinfo::CharinfoPeer& peer, sol::this_state L) {
+	return sol::property([member, sections](const charinfo::CharinfoPeer& peer, sol::this_state L) {
+		charinfo::NoteSectionRead(sections);
 		if (peer.invalidated())
 			return sol::make_object(L, sol::lua_nil);
 
@@ -72,10 +80,11 @@ static void RegisterCharInfoUsertypes(sol::state_view L)
 	L.new_usertype<charinfo::PeerBuffEntry>(
 		"PeerBuffEntry", sol::no_constructor,
 		"Spell", &charinfo::PeerBuffEntry::spell,
-		"Duration", &charinfo::PeerBuffEntry::duration,
-		sol::meta_function::equal_to, [](const charinfo::PeerBuffEntry& a, const charinfo::PeerBuffEntry& b) { return a.duration == b.duration && std::tie(a.spell.name, a.spell.id, a.spell.category, a.spell.level) == std::tie(b.spell.name, b.spell.id, b.spell.category, b.spell.level); },
-		sol::meta_function::less_than, [](const charinfo::PeerBuffEntry& a, const charinfo::PeerBuffEntry& b) { return std::tie(a.duration, a.spell.name, a.spell.id) < std::tie(b.duration, b.spell.name, b.spell.id); },
-		sol::meta_function::less_than_or_equal_to, [](const charinfo::PeerBuffEntry& a, const charinfo::PeerBuffEntry& b) { return std::tie(a.duration, a.spell.name, a.spell.id) <= std::tie(b.duration, b.spell.name, b.spell.id); });
+		// Remaining time is computed on read from the buff's expiry.
+		"Duration", sol::property(&charinfo::PeerBuffEntry::Remaining),
+		sol::meta_function::equal_to, [](const charinfo::PeerBuffEntry& a, const charinfo::PeerBuffEntry& b) { return a.Remaining() == b.Remaining() && std::tie(a.spell.name, a.spell.id, a.spell.category, a.spell.level) == std::tie(b.spell.name, b.spell.id, b.spell.category, b.spell.level); },
+		sol::meta_function::less_than, [](const charinfo::PeerBuffEntry& a, const charinfo::PeerBuffEntry& b) { const int32_t ra = a.Remaining(), rb = b.Remaining(); return std::tie(ra, a.spell.name, a.spell.id) < std::tie(rb, b.spell.name, b.spell.id); },
+		sol::meta_function::less_than_or_equal_to, [](const charinfo::PeerBuffEntry& a, const charinfo::PeerBuffEntry& b) { const int32_t ra = a.Remaining(), rb = b.Remaining(); return std::tie(ra, a.spell.name, a.spell.id) <= std::tie(rb, b.spell.name, b.spell.id); });
 
 	L.new_usertype<charinfo::PeerClassInfo>(
 		"PeerClassInfo", sol::no_constructor,
@@ -100,17 +109,18 @@ static void RegisterCharInfoUsertypes(sol::state_view L)
 		"ShortName", &charinfo::PeerZoneInfo::short_name,
 		"ID", &charinfo::PeerZoneInfo::id,
 		"InstanceID", &charinfo::PeerZoneInfo::instance_id,
-		"X", &charinfo::PeerZoneInfo::x,
-		"Y", &charinfo::PeerZoneInfo::y,
-		"Z", &charinfo::PeerZoneInfo::z,
+		"X", sol::property(&charinfo::PeerZoneInfo::X),
+		"Y", sol::property(&charinfo::PeerZoneInfo::Y),
+		"Z", sol::property(&charinfo::PeerZoneInfo::Z),
 		"Heading", &charinfo::PeerZoneInfo::heading,
 		"Distance", sol::property([](const charinfo::PeerZoneInfo &z, sol::this_state L) {
-			if (z.distance < 0)
+			const double distance = charinfo::ZoneDistance(z);
+			if (distance < 0)
 				return sol::make_object(L, sol::lua_nil);
-			return sol::make_object(L, z.distance); }),
-		sol::meta_function::equal_to, [](const charinfo::PeerZoneInfo& a, const charinfo::PeerZoneInfo& b) { return std::tie(a.name, a.short_name, a.id, a.instance_id, a.x, a.y, a.z, a.heading, a.distance) == std::tie(b.name, b.short_name, b.id, b.instance_id, b.x, b.y, b.z, b.heading, b.distance); },
-		sol::meta_function::less_than, [](const charinfo::PeerZoneInfo& a, const charinfo::PeerZoneInfo& b) { return std::tie(a.name, a.short_name, a.id, a.instance_id, a.x, a.y, a.z, a.heading, a.distance) < std::tie(b.name, b.short_name, b.id, b.instance_id, b.x, b.y, b.z, b.heading, b.distance); },
-		sol::meta_function::less_than_or_equal_to, [](const charinfo::PeerZoneInfo& a, const charinfo::PeerZoneInfo& b) { return std::tie(a.name, a.short_name, a.id, a.instance_id, a.x, a.y, a.z, a.heading, a.distance) <= std::tie(b.name, b.short_name, b.id, b.instance_id, b.x, b.y, b.z, b.heading, b.distance); });
+			return sol::make_object(L, distance); }),
+		sol::meta_function::equal_to, [](const charinfo::PeerZoneInfo& a, const charinfo::PeerZoneInfo& b) { return std::tie(a.name, a.short_name, a.id, a.instance_id, a.x, a.y, a.z, a.heading, a.fix_ms) == std::tie(b.name, b.short_name, b.id, b.instance_id, b.x, b.y, b.z, b.heading, b.fix_ms); },
+		sol::meta_function::less_than, [](const charinfo::PeerZoneInfo& a, const charinfo::PeerZoneInfo& b) { return std::tie(a.name, a.short_name, a.id, a.instance_id, a.x, a.y, a.z, a.heading, a.fix_ms) < std::tie(b.name, b.short_name, b.id, b.instance_id, b.x, b.y, b.z, b.heading, b.fix_ms); },
+		sol::meta_function::less_than_or_equal_to, [](const charinfo::PeerZoneInfo& a, const charinfo::PeerZoneInfo& b) { return std::tie(a.name, a.short_name, a.id, a.instance_id, a.x, a.y, a.z, a.heading, a.fix_ms) <= std::tie(b.name, b.short_name, b.id, b.instance_id, b.x, b.y, b.z, b.heading, b.fix_ms); });
 
 	L.new_usertype<charinfo::PeerExperienceInfo>(
 		"PeerExperienceInfo", sol::no_constructor,
@@ -212,61 +222,68 @@ static void RegisterCharInfoUsertypes(sol::state_view L)
 	// CharinfoPeer: usertype bound directly to the underlying peer object.
 	L.new_usertype<charinfo::CharinfoPeer>(
 		"CharinfoPeer", sol::no_constructor,
-		"Name", MakePeerFieldProperty(&charinfo::CharinfoPeer::name),
-		"ID", MakePeerFieldProperty(&charinfo::CharinfoPeer::id),
-		"Level", MakePeerFieldProperty(&charinfo::CharinfoPeer::level),
-		"PctHPs", MakePeerFieldProperty(&charinfo::CharinfoPeer::pct_hps),
-		"PctMana", MakePeerFieldProperty(&charinfo::CharinfoPeer::pct_mana),
-		"TargetHP", MakePeerFieldProperty(&charinfo::CharinfoPeer::target_hp),
-		"FreeBuffSlots", MakePeerFieldProperty(&charinfo::CharinfoPeer::free_buff_slots),
-		"Detrimentals", MakePeerFieldProperty(&charinfo::CharinfoPeer::detrimentals),
-		"CountPoison", MakePeerFieldProperty(&charinfo::CharinfoPeer::count_poison),
-		"CountDisease", MakePeerFieldProperty(&charinfo::CharinfoPeer::count_disease),
-		"CountCurse", MakePeerFieldProperty(&charinfo::CharinfoPeer::count_curse),
-		"CountCorruption", MakePeerFieldProperty(&charinfo::CharinfoPeer::count_corruption),
-		"PetHP", MakePeerFieldProperty(&charinfo::CharinfoPeer::pet_hp),
-		"MaxEndurance", MakePeerFieldProperty(&charinfo::CharinfoPeer::max_endurance),
-		"CurrentHP", MakePeerFieldProperty(&charinfo::CharinfoPeer::current_hp),
-		"MaxHP", MakePeerFieldProperty(&charinfo::CharinfoPeer::max_hp),
-		"CurrentMana", MakePeerFieldProperty(&charinfo::CharinfoPeer::current_mana),
-		"MaxMana", MakePeerFieldProperty(&charinfo::CharinfoPeer::max_mana),
-		"CurrentEndurance", MakePeerFieldProperty(&charinfo::CharinfoPeer::current_endurance),
-		"PctEndurance", MakePeerFieldProperty(&charinfo::CharinfoPeer::pct_endurance),
-		"PetID", MakePeerFieldProperty(&charinfo::CharinfoPeer::pet_id),
-		"PetAffinity", MakePeerFieldProperty(&charinfo::CharinfoPeer::pet_affinity),
-		"NoCure", MakePeerFieldProperty(&charinfo::CharinfoPeer::no_cure),
-		"LifeDrain", MakePeerFieldProperty(&charinfo::CharinfoPeer::life_drain),
-		"ManaDrain", MakePeerFieldProperty(&charinfo::CharinfoPeer::mana_drain),
-		"EnduDrain", MakePeerFieldProperty(&charinfo::CharinfoPeer::endu_drain),
-		"Version", MakePeerFieldProperty(&charinfo::CharinfoPeer::version),
-		"CombatState", MakePeerFieldProperty(&charinfo::CharinfoPeer::combat_state),
-		"CastingSpellID", MakePeerFieldProperty(&charinfo::CharinfoPeer::casting_spell_id),
-		"Class", MakePeerFieldProperty(&charinfo::CharinfoPeer::class_info),
-		"Target", MakePeerFieldProperty(&charinfo::CharinfoPeer::target),
-		"Zone", MakePeerFieldProperty(&charinfo::CharinfoPeer::zone),
-		"State", MakePeerTableProperty(&charinfo::CharinfoPeer::state),
-		"BuffState", MakePeerTableProperty(&charinfo::CharinfoPeer::buff_state),
-		"Buff", MakePeerTableProperty(&charinfo::CharinfoPeer::buff),
-		"ShortBuff", MakePeerTableProperty(&charinfo::CharinfoPeer::short_buff),
-		"PetBuff", MakePeerTableProperty(&charinfo::CharinfoPeer::pet_buff),
-		"Gems", MakePeerTableProperty(&charinfo::CharinfoPeer::gems),
-		"FreeInventory", MakePeerTableProperty(&charinfo::CharinfoPeer::free_inventory),
+		"Name", MakePeerFieldProperty(&charinfo::CharinfoPeer::name, SectionBit(PublishSection::Identity)),
+		"ID", MakePeerFieldProperty(&charinfo::CharinfoPeer::id, SectionBit(PublishSection::Identity)),
+		"Level", MakePeerFieldProperty(&charinfo::CharinfoPeer::level, SectionBit(PublishSection::Identity)),
+		"PctHPs", MakePeerFieldProperty(&charinfo::CharinfoPeer::pct_hps, SectionBit(PublishSection::Vitals)),
+		"PctMana", MakePeerFieldProperty(&charinfo::CharinfoPeer::pct_mana, SectionBit(PublishSection::Vitals)),
+		"TargetHP", MakePeerFieldProperty(&charinfo::CharinfoPeer::target_hp, SectionBit(PublishSection::Target)),
+		"FreeBuffSlots", MakePeerFieldProperty(&charinfo::CharinfoPeer::free_buff_slots, SectionBit(PublishSection::Buffs)),
+		"Detrimentals", MakePeerFieldProperty(&charinfo::CharinfoPeer::detrimentals, SectionBit(PublishSection::Buffs)),
+		"CountPoison", MakePeerFieldProperty(&charinfo::CharinfoPeer::count_poison, SectionBit(PublishSection::Buffs)),
+		"CountDisease", MakePeerFieldProperty(&charinfo::CharinfoPeer::count_disease, SectionBit(PublishSection::Buffs)),
+		"CountCurse", MakePeerFieldProperty(&charinfo::CharinfoPeer::count_curse, SectionBit(PublishSection::Buffs)),
+		"CountCorruption", MakePeerFieldProperty(&charinfo::CharinfoPeer::count_corruption, SectionBit(PublishSection::Buffs)),
+		"PetHP", MakePeerFieldProperty(&charinfo::CharinfoPeer::pet_hp, SectionBit(PublishSection::Pet)),
+		"MaxEndurance", MakePeerFieldProperty(&charinfo::CharinfoPeer::max_endurance, SectionBit(PublishSection::Vitals)),
+		"CurrentHP", MakePeerFieldProperty(&charinfo::CharinfoPeer::current_hp, SectionBit(PublishSection::Vitals)),
+		"MaxHP", MakePeerFieldProperty(&charinfo::CharinfoPeer::max_hp, SectionBit(PublishSection::Vitals)),
+		"CurrentMana", MakePeerFieldProperty(&charinfo::CharinfoPeer::current_mana, SectionBit(PublishSection::Vitals)),
+		"MaxMana", MakePeerFieldProperty(&charinfo::CharinfoPeer::max_mana, SectionBit(PublishSection::Vitals)),
+		"CurrentEndurance", MakePeerFieldProperty(&charinfo::CharinfoPeer::current_endurance, SectionBit(PublishSection::Vitals)),
+		"PctEndurance", MakePeerFieldProperty(&charinfo::CharinfoPeer::pct_endurance, SectionBit(PublishSection::Vitals)),
+		"PetID", MakePeerFieldProperty(&charinfo::CharinfoPeer::pet_id, SectionBit(PublishSection::Pet)),
+		"PetAffinity", MakePeerFieldProperty(&charinfo::CharinfoPeer::pet_affinity, SectionBit(PublishSection::Pet)),
+		"NoCure", MakePeerFieldProperty(&charinfo::CharinfoPeer::no_cure, SectionBit(PublishSection::Vitals)),
+		"LifeDrain", MakePeerFieldProperty(&charinfo::CharinfoPeer::life_drain, SectionBit(PublishSection::Vitals)),
+		"ManaDrain", MakePeerFieldProperty(&charinfo::CharinfoPeer::mana_drain, SectionBit(PublishSection::Vitals)),
+		"EnduDrain", MakePeerFieldProperty(&charinfo::CharinfoPeer::endu_drain, SectionBit(PublishSection::Vitals)),
+		"Version", MakePeerFieldProperty(&charinfo::CharinfoPeer::version, SectionBit(PublishSection::Identity)),
+		"Channel", sol::readonly(&charinfo::CharinfoPeer::channel),
+		"CombatState", MakePeerFieldProperty(&charinfo::CharinfoPeer::combat_state, SectionBit(PublishSection::Vitals)),
+		"CastingSpellID", MakePeerFieldProperty(&charinfo::CharinfoPeer::casting_spell_id, SectionBit(PublishSection::Vitals)),
+		"Class", MakePeerFieldProperty(&charinfo::CharinfoPeer::class_info, SectionBit(PublishSection::Identity)),
+		"Target", MakePeerFieldProperty(&charinfo::CharinfoPeer::target, SectionBit(PublishSection::Target)),
+		"Zone", MakePeerFieldProperty(&charinfo::CharinfoPeer::zone, SectionBit(PublishSection::Zone)),
+		"State", MakePeerTableProperty(&charinfo::CharinfoPeer::state, SectionBit(PublishSection::Vitals)),
+		"BuffState", MakePeerTableProperty(&charinfo::CharinfoPeer::buff_state, SectionBit(PublishSection::Vitals)),
+		"Buff", MakePeerTableProperty(&charinfo::CharinfoPeer::buff, SectionBit(PublishSection::Buffs) | SectionBit(PublishSection::BuffTimers)),
+		"ShortBuff", MakePeerTableProperty(&charinfo::CharinfoPeer::short_buff, SectionBit(PublishSection::Buffs) | SectionBit(PublishSection::BuffTimers)),
+		"PetBuff", MakePeerTableProperty(&charinfo::CharinfoPeer::pet_buff, SectionBit(PublishSection::Pet) | SectionBit(PublishSection::BuffTimers)),
+		"Gems", MakePeerTableProperty(&charinfo::CharinfoPeer::gems, SectionBit(PublishSection::Gems)),
+		"FreeInventory", MakePeerTableProperty(&charinfo::CharinfoPeer::free_inventory, SectionBit(PublishSection::Inventory)),
 		"Experience", sol::property([](const charinfo::CharinfoPeer &peer, sol::this_state L) {
+			charinfo::NoteSectionRead(SectionBit(PublishSection::Experience));
 			if (peer.invalidated() || !peer.has_experience) return sol::make_object(L, sol::lua_nil);
 			return sol::make_object(L, peer.experience); }),
 		"MakeCamp", sol::property([](const charinfo::CharinfoPeer &peer, sol::this_state L) {
+			charinfo::NoteSectionRead(SectionBit(PublishSection::MakeCamp));
 			if (peer.invalidated() || !peer.has_make_camp) return sol::make_object(L, sol::lua_nil);
 			return sol::make_object(L, peer.make_camp); }),
 		"Macro", sol::property([](const charinfo::CharinfoPeer &peer, sol::this_state L) {
+			charinfo::NoteSectionRead(SectionBit(PublishSection::Macro));
 			if (peer.invalidated() || !peer.has_macro) return sol::make_object(L, sol::lua_nil);
 			return sol::make_object(L, peer.macro); }),
 		"Lua", sol::property([](const charinfo::CharinfoPeer &peer, sol::this_state L) {
+			charinfo::NoteSectionRead(SectionBit(PublishSection::Lua));
 			if (peer.invalidated() || !peer.has_lua) return sol::make_object(L, sol::lua_nil);
 			return sol::make_object(L, peer.lua); }),
 		"Stacks", sol::overload(
 			[](const charinfo::CharinfoPeer &peer, const std::string &spell) {
+				charinfo::NoteSectionRead(SectionBit(PublishSection::Buffs));
 				return !peer.invalidated() && charinfo::StacksForPeer(peer, spell.c_str()); },
 			[](const charinfo::CharinfoPeer &peer, const sol::object &spellArg) -> bool {
+				charinfo::NoteSectionRead(SectionBit(PublishSection::Buffs));
 				if (peer.invalidated()) return false;
 				sol::type t = spellArg.get_type();
 				if (t == sol::type::string) return charinfo::StacksForPeer(peer, spellArg.as<std::string>().c_str());
@@ -274,8 +291,10 @@ static void RegisterCharInfoUsertypes(sol::state_view L)
 				return false; }),
 		"StacksPet", sol::overload(
 			[](const charinfo::CharinfoPeer &peer, const std::string &spell) {
+				charinfo::NoteSectionRead(SectionBit(PublishSection::Pet));
 				return !peer.invalidated() && charinfo::StacksPetForPeer(peer, spell.c_str()); },
 			[](const charinfo::CharinfoPeer &peer, const sol::object &spellArg) -> bool {
+				charinfo::NoteSectionRead(SectionBit(PublishSection::Pet));
 				if (peer.invalidated()) return false;
 				sol::type t = spellArg.get_type();
 				if (t == sol::type::string) return charinfo::StacksPetForPeer(peer, spellArg.as<std::string>().c_str());
@@ -308,12 +327,15 @@ PLUGIN_API bool CreateLuaModule(sol::this_state s, sol::object& out_module)
 		return sol::make_object(L, it->second);
 	};
 
-	module["GetPeers"] = [](sol::this_state L)
+	// GetPeers(channel) / GetPeerCnt(channel): only the peers publishing on that channel ("" = default).
+	module["GetPeers"] = [](sol::this_state L, sol::optional<std::string> channel)
 	{
 		sol::state_view sv(L);
 		std::vector<std::string> names;
-		for (const auto &p : charinfo::GetPeers())
-			names.push_back(p.first);
+		for (const auto &p : charinfo::GetPeers()) {
+			if (p.second && (!channel || p.second->channel == *channel))
+				names.push_back(p.first);
+		}
 		std::sort(names.begin(), names.end());
 		sol::table arr = sv.create_table();
 		for (size_t i = 0; i < names.size(); i++)
@@ -321,9 +343,10 @@ PLUGIN_API bool CreateLuaModule(sol::this_state s, sol::object& out_module)
 		return sol::make_object(L, arr);
 	};
 
-	module["GetPeerCnt"] = []()
+	module["GetPeerCnt"] = [](sol::optional<std::string> channel)
 	{
-		return static_cast<int>(charinfo::GetPeers().size());
+		return static_cast<int>(std::count_if(charinfo::GetPeers().begin(), charinfo::GetPeers().end(),
+			[&channel](const auto &p) { return p.second && (!channel || p.second->channel == *channel); }));
 	};
 
 	// Callable: charinfo(name) == GetInfo(name).
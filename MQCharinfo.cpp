@@ -6,12 +6,29 @@
 #include "mq/Plugin.h"
 #include "Charinfo.h"
 #include "CharinfoPanel.h"
+#include "Compression.h"
+#include "JoinReplies.h"
+#include "PackedUpdates.h"
+#include "PublishScheduler.h"
+#include "SharedSnapshots.h"
+#include "SharedVitals.h"
+#include "SpellCache.h"
+#include "Transport.h"
+#include "UpdateRouting.h"
 #include "charinfo.pb.h"
 
 #include <eqlib/game/Constants.h>
 
+#include <algorithm>
+#include <array>
 #include <chrono>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <random>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "mq/contrib/protobuf/ProtobufLibs.h"
 
@@ -20,16 +37,351 @@ PLUGIN_VERSION(charinfo::CHARINFO_VERSION);
 
 static postoffice::DropboxAPI s_charinfoDropbox;
 static bool s_actorRegistered = false;
-static std::chrono::steady_clock::time_point s_nextPublish;
-static const std::chrono::milliseconds s_publishInterval(1000);
+static charinfo::PublishScheduler s_scheduler;
+// GetCombatState(): 0 = COMBAT, 1 = DEBUFFED, 2 = COOLDOWN, 3 = ACTIVE, 4 = RESTING.
+static constexpr int s_combatStateCombat = 0;
 
+static charinfo::PublishSampler s_sampler;
+static mq::proto::charinfo::CharinfoPublish s_current;
 static mq::proto::charinfo::CharinfoPublish s_lastPublished;
 static bool Initialized = false;
 static bool s_initialized = false;
 static bool s_justZoned = false;
+// An older peer appeared after our last full publish; resend it in a form that peer can read
+// (expanded spell data for pre-1.8, uncompressed for pre-2.0).
+static bool s_compatPublishPending = false;
+// Opt-in (INI Compression=1): compress full publishes when every peer can decode them.
+static bool s_compression = false;
+// INI CaptureDir: where to write our full publishes, uncompressed, as training samples for the
+// compression dictionary (bench/train_dictionary.py). Empty = off.
+static std::string s_captureDir;
+static int s_capturedPublishes = 0;
+static constexpr int s_maxCapturedPublishes = 2000;
 static std::string s_settingsPanelId;
 
-static void HandleMessage(const std::shared_ptr<postoffice::Message>& message)
+// Channels (INI Channel / Listen): a channel is a mailbox of its own, so broadcasts reach only its
+// members. We publish on our home channel and also read the listened ones. The default channel
+// keeps the "charinfo" mailbox, so clients without a Channel setting still meet there.
+// Channel=auto follows the raid, else the group, we are in (checked every s_channelCheckIntervalMs).
+struct ListenedChannel {
+	std::string name;
+	postoffice::DropboxAPI dropbox;
+};
+static bool s_autoChannel = false;
+static std::string s_homeChannel;
+static std::vector<ListenedChannel> s_listenedChannels;
+static int64_t s_channelCheckMs = 0;
+static constexpr int64_t s_channelCheckIntervalMs = 1000;
+
+static std::string ChannelMailbox(const std::string& channel)
+{
+	return channel.empty() ? std::string("charinfo") : "charinfo_" + channel;
+}
+
+// Postoffice delivery through our home dropbox; the broadcast address of the last channel is kept.
+class PostofficeTransport : public charinfo::Transport {
+public:
+	void Broadcast(const std::string& channel, const std::string& wire) override
+	{
+		if (!m_broadcast.Server || channel != m_broadcastChannel) {
+			m_broadcast.Server = GetServerShortName();
+			m_broadcast.Mailbox = ChannelMailbox(channel);
+			m_broadcastChannel = channel;
+		}
+		s_charinfoDropbox.Post(m_broadcast, wire);
+	}
+
+	void Send(const std::string& character, const std::string& channel, const std::string& wire) override
+	{
+		postoffice::Address address;
+		address.Server = GetServerShortName();
+		address.Character = character;
+		address.Mailbox = ChannelMailbox(channel);
+		s_charinfoDropbox.Post(address, wire);
+	}
+
+	void Reset()
+	{
+		m_broadcast = postoffice::Address();
+		m_broadcastChannel.clear();
+	}
+
+private:
+	postoffice::Address m_broadcast;
+	std::string m_broadcastChannel;
+};
+static PostofficeTransport s_postoffice;
+static charinfo::Transport* s_transport = &s_postoffice;
+
+// Serialization buffers, reused by every send.
+static std::string s_wireBuffer;
+static std::string s_compressBuffer;
+// Decompressed body of the last compressed message received.
+static std::string s_inflateBuffer;
+
+// Sequence number of our last update; carried by full publishes so receivers can spot gaps.
+static uint32_t s_seq = 0;
+// When we last asked each sender for a resync (ClockMs), so one gap doesn't flood the sender.
+static std::unordered_map<std::string, int64_t> s_resyncRequestedAt;
+static constexpr int64_t s_resyncIntervalMs = 2000;
+// Updates this far behind the last applied one are reordered leftovers; further back, the sender restarted.
+static constexpr int32_t s_staleSeqWindow = 64;
+
+// Checkpoints: an update carries a StateChecksum every s_checkpointUpdates updates or
+// s_checkpointIntervalMs, whichever comes first (INI CheckpointUpdates / CheckpointInterval).
+// The first one is offset by a per-character phase so a group started together doesn't align.
+static int s_checkpointUpdates = 100;
+static int s_checkpointIntervalMs = 30000;
+static constexpr int s_minCheckpointIntervalMs = 1000;
+static int s_updatesSinceCheckpoint = 0;
+static int64_t s_nextCheckpointMs = 0;
+
+// Update lanes: identity, vitals and target changes are the priority lane, the other sections the
+// bulk lane. An update the bulk lane would push past s_bulkMessageBytes (INI BulkMessageBytes) is
+// split, and receivers of a hub batch apply priority updates ahead of bulk ones.
+static constexpr charinfo::SectionMask s_priorityLane = charinfo::SectionBit(charinfo::PublishSection::Identity)
+	| charinfo::SectionBit(charinfo::PublishSection::Vitals) | charinfo::SectionBit(charinfo::PublishSection::Target);
+static int s_bulkMessageBytes = 1024;
+static constexpr int s_minBulkMessageBytes = 256;
+// Updates are built here rather than on the frame arena so bulk fields can move between the two
+// without copies; cleared, both keep their allocations for the next send.
+static mq::proto::charinfo::CharinfoMessage s_updateMessage;
+static mq::proto::charinfo::CharinfoUpdate s_bulkUpdate;
+
+// Joined replies: joiners are collected and answered together after a random delay, directly
+// when a few peers joined and with one broadcast when most of the group did (a raid zoning in).
+// A joiner that still holds a recent version of our snapshot gets "unchanged" or a replay of the
+// updates it missed instead.
+struct PendingJoinReply {
+	std::string joiner;
+	// Version of our snapshot the joiner advertised (checksum 0 = none).
+	uint32_t seq = 0;
+	uint64_t checksum = 0;
+};
+static std::vector<PendingJoinReply> s_pendingJoinReplies;
+static int64_t s_joinReplyAtMs = 0;
+static std::minstd_rand s_joinReplyJitter(static_cast<unsigned>(std::chrono::steady_clock::now().time_since_epoch().count()));
+
+// Subscriptions: each reader advertises the sections its Lua scripts and settings panel read
+// (CharinfoSubscribe), and only sections some peer subscribes to are sampled. Reads decay after
+// s_readDecayMs; subscriptions are re-sent every s_subscribeKeepaliveMs and forgotten after
+// s_subscriptionTtlMs. Identity is always sampled: receivers need it to resolve everything else.
+struct Subscription {
+	charinfo::SectionMask sections = 0;
+	int64_t received_ms = 0;
+	bool hub_candidate = false;
+};
+static std::unordered_map<std::string, Subscription> s_subscriptions;
+static charinfo::SectionMask s_advertisedSections = 0;
+static int64_t s_lastSubscribeMs = 0;
+static constexpr int64_t s_readDecayMs = 60000;
+static constexpr int64_t s_subscribeKeepaliveMs = 30000;
+static constexpr int64_t s_subscriptionTtlMs = 90000;
+static constexpr charinfo::SectionMask s_requiredSections = charinfo::SectionBit(charinfo::PublishSection::Identity);
+
+// Position routing: a Zone change that only moved us goes straight to the peers in our zone and
+// instance, unsequenced so the others see no gap. Peers elsewhere get it by broadcast at most
+// every s_crossZonePositionMs (zone changes themselves are always broadcast).
+static constexpr int64_t s_crossZonePositionMs = 10000;
+static int64_t s_lastPositionBroadcastMs = 0;
+
+// Dead reckoning (2.5+): a new position fix is published only once extrapolating the last one
+// misses by more than s_positionThreshold units (INI PositionThreshold).
+static charinfo::PositionTracker s_positionTracker;
+static float s_positionThreshold = 2.0f;
+
+// Session string dictionary (2.6+) for our broadcasts: keyframed by every full publish.
+static charinfo::SessionStrings s_sessionStrings;
+
+// Hub mode (2.7+): candidates (INI Hub=1) advertise themselves in CharinfoSubscribe and the one with
+// the lowest name is elected. Everyone posts updates to the hub, which broadcasts what it collected
+// as one CharinfoBatch every s_hubIntervalMs (INI HubInterval), or an empty one every
+// s_hubHeartbeatMs when idle. A hub not heard from for s_hubTimeoutMs is passed over for s_hubRetryMs.
+static bool s_hubCandidate = false;
+static std::string s_hub;
+static int64_t s_hubElectedMs = 0;
+static int s_hubIntervalMs = 100;
+static constexpr int s_minHubIntervalMs = 20;
+static constexpr int64_t s_hubHeartbeatMs = 1000;
+static constexpr int64_t s_hubTimeoutMs = 3000;
+static constexpr int64_t s_hubRetryMs = 30000;
+static std::unordered_map<std::string, int64_t> s_hubHeardMs;
+static std::unordered_map<std::string, int64_t> s_hubFailedUntil;
+static mq::proto::charinfo::CharinfoBatch s_hubBatch;
+static int64_t s_lastBatchMs = 0;
+// Our newest update known to have gone out to everyone (broadcast ourselves, or seen in a batch).
+static uint32_t s_lastRelayedSeq = 0;
+// Bulk updates of a received batch (by index), and their senders, held back until its priority
+// updates are applied.
+static std::vector<int> s_deferredUpdates;
+static std::vector<std::string> s_deferredSenders;
+
+// Same-machine snapshots (INI SharedMemory, on by default): our last published snapshot is kept in
+// a shared-memory slot, and peers with a live slot are read from it instead of from their updates.
+// Updates are not posted at all while every peer reads our slot. When only the vitals and target
+// changed, just the slot's fixed-layout vitals are rewritten and readers patch their copy in place.
+static charinfo::SharedSnapshots s_sharedSnapshots;
+static charinfo::SectionMask s_sharedDirtySections = 0;
+static constexpr charinfo::SectionMask s_sharedVitalsSections = charinfo::SectionBit(charinfo::PublishSection::Vitals)
+	| charinfo::SectionBit(charinfo::PublishSection::Target);
+static charinfo::SharedVitals s_sharedVitals;
+static int64_t s_sharedTouchMs = 0;
+static constexpr int64_t s_sharedTouchIntervalMs = 1000;
+static std::string s_sharedBuffer;
+static mq::proto::charinfo::CharinfoPublish s_sharedPublish;
+
+// Recently sent updates by seq (wire bytes), with the checksum of our snapshot after each one.
+struct SentUpdate {
+	uint32_t seq = 0;
+	uint64_t checksum = 0;
+	std::string wire;
+};
+static constexpr uint32_t s_sentUpdateHistory = 64;
+static std::array<SentUpdate, s_sentUpdateHistory> s_sentUpdates;
+// StateChecksum(s_lastPublished), kept current by every send.
+static uint64_t s_lastPublishedChecksum = 0;
+
+static void SendFullPublish(mq::proto::charinfo::CharinfoPublish* payload, const std::string& recipient = std::string());
+static void SendResync(const std::string& sender, const std::string& channel);
+
+// Track the update sequence for a peer. Returns false when the update is stale and must be dropped;
+// asks the sender for a fresh snapshot when updates went missing.
+static bool AcceptSequence(const std::string& sender, charinfo::CharinfoPeer& peer, uint32_t seq)
+{
+	if (seq == 0)
+		return true;
+	if (peer.seq != 0) {
+		const int32_t step = static_cast<int32_t>(seq - peer.seq);
+		if (step <= 0 && step > -s_staleSeqWindow) {
+			charinfo::GetPublishStats().stale_updates++;
+			return false;
+		}
+		if (step != 1) {
+			charinfo::GetPublishStats().sequence_gaps++;
+			SendResync(sender, peer.channel);
+		}
+	}
+	peer.seq = seq;
+	return true;
+}
+
+static void QueueJoinReply(const std::string& joiner, uint32_t seq, uint64_t checksum)
+{
+	auto it = std::find_if(s_pendingJoinReplies.begin(), s_pendingJoinReplies.end(),
+		[&joiner](const PendingJoinReply& reply) { return reply.joiner == joiner; });
+	if (it != s_pendingJoinReplies.end()) {
+		it->seq = seq;
+		it->checksum = checksum;
+		return;
+	}
+	if (s_pendingJoinReplies.empty())
+		s_joinReplyAtMs = charinfo::ClockMs() + charinfo::kJoinReplyMinDelayMs
+			+ static_cast<int64_t>(s_joinReplyJitter() % (charinfo::kJoinReplyJitterMs + 1));
+	else
+		charinfo::GetPublishStats().joins_coalesced++;
+	s_pendingJoinReplies.push_back({ joiner, seq, checksum });
+}
+
+// Sections some reader of our channel wants: its members and the listeners from other channels. A
+// member that predates subscriptions, or that we have no current subscription from yet, is assumed
+// to read everything.
+static charinfo::SectionMask InterestMask()
+{
+	const int64_t now = charinfo::ClockMs();
+	charinfo::SectionMask sections = s_requiredSections;
+	for (const auto& [name, peer] : charinfo::GetPeers()) {
+		if (!peer || peer->channel != s_homeChannel)
+			continue;
+		if (peer->version < charinfo::CHARINFO_VERSION_SUBSCRIPTIONS)
+			return charinfo::kAllSections;
+		auto it = s_subscriptions.find(name);
+		if (it == s_subscriptions.end() || now - it->second.received_ms >= s_subscriptionTtlMs)
+			return charinfo::kAllSections;
+	}
+	for (const auto& [name, subscription] : s_subscriptions) {
+		if (now - subscription.received_ms < s_subscriptionTtlMs)
+			sections |= subscription.sections;
+	}
+	return sections;
+}
+
+// Compare a sender's checkpoint with our copy of its state; on mismatch, fetch a fresh snapshot.
+static void VerifyCheckpoint(const std::string& sender, const charinfo::CharinfoPeer& peer, uint64_t checkpoint)
+{
+	charinfo::PublishStats& stats = charinfo::GetPublishStats();
+	stats.checkpoints_verified++;
+	if (charinfo::StateChecksum(peer) != checkpoint) {
+		stats.checkpoint_mismatches++;
+		SendResync(sender, peer.channel);
+	}
+}
+
+// True if some reader needs our updates by postoffice: everyone while we hold no shared-memory slot,
+// else a member of our channel that does not read our slot, a listener from another channel, or we
+// know of no members yet.
+static bool RemotePeers()
+{
+	if (!charinfo::SlotServesMembers(s_sharedSnapshots, charinfo::GetPeers(), s_homeChannel))
+		return true;
+	const int64_t now = charinfo::ClockMs();
+	for (const auto& [name, subscription] : s_subscriptions) {
+		if (now - subscription.received_ms < s_subscriptionTtlMs
+			&& charinfo::GetPeers().find(name) == charinfo::GetPeers().end())
+			return true;
+	}
+	return false;
+}
+
+static bool IsHub()
+{
+	return !s_hub.empty() && s_hub == s_current.sender();
+}
+
+// Apply a peer's update, received on `channel` directly or inside a hub batch.
+static void ApplyUpdate(mq::proto::charinfo::CharinfoUpdate& update, const std::string& channel)
+{
+	const std::string& sender = update.sender();
+	if (sender.empty())
+		return;
+	auto it = charinfo::GetPeers().find(sender);
+	if (it == charinfo::GetPeers().end()) {
+		// Missed the sender's publish (or it predates us): deltas are useless without a snapshot.
+		SendResync(sender, channel);
+		return;
+	}
+	if (it->second->shared_memory)
+		return;
+	if (!AcceptSequence(sender, *it->second, update.seq()))
+		return;
+	if (update.clock_ms() != 0)
+		it->second->clock_offset = charinfo::ClockMs() - update.clock_ms();
+	if (!charinfo::ResolveSessionStrings(&update, it->second.get())) {
+		// A token we never saw defined: our table for this sender is out of step.
+		SendResync(sender, it->second->channel);
+		return;
+	}
+	if (!update.packed().empty() && !charinfo::ApplyPackedUpdates(update.packed(), it->second.get())) {
+		// Malformed packed fields: some of our copy's scalars may be stale or garbled.
+		charinfo::GetPublishStats().update_apply_failures++;
+		SendResync(sender, it->second->channel);
+		return;
+	}
+	for (int i = 0; i < update.updates_size(); i++) {
+		if (!charinfo::ApplyFieldUpdate(update.updates(i), it->second.get())) {
+			// A list delta that doesn't fit our copy: the rest of the update builds on state we don't have.
+			charinfo::GetPublishStats().update_apply_failures++;
+			SendResync(sender, it->second->channel);
+			return;
+		}
+	}
+	if (update.checkpoint() != 0)
+		VerifyCheckpoint(sender, *it->second, update.checkpoint());
+	charinfo::GetPublishStats().received_updates++;
+}
+
+// Handle a message that arrived in our mailbox for `channel`. On a listened channel we only read:
+// its members' joins, resync requests and subscriptions are for the members to answer.
+static void DispatchMessage(const std::shared_ptr<postoffice::Message>& message, const std::string& channel)
 {
 	if (!message || !message->Payload)
 		return;
@@ -37,28 +389,77 @@ static void HandleMessage(const std::shared_ptr<postoffice::Message>& message)
 	mq::proto::charinfo::CharinfoMessage msg;
 	if (!msg.ParseFromString(*message->Payload))
 		return;
+	if (msg.compression() != mq::proto::charinfo::COMPRESSION_NONE) {
+		if (!charinfo::DecompressPayload(msg.compressed(), &s_inflateBuffer, msg.compression())
+			|| !msg.ParseFromString(s_inflateBuffer))
+			return;
+	}
 
 	using Id = mq::proto::charinfo::CharinfoMessageId;
 
 	if (msg.id() == Id::Publish && msg.has_publish()) {
 		const std::string& sender = msg.publish().sender();
 		if (!sender.empty()) {
+			charinfo::PeerMap& peers = charinfo::GetPeers();
+			auto it = peers.find(sender);
+			const bool known = it != peers.end() && it->second;
+			if (known && it->second->shared_memory)
+				return;
 			charinfo::CharinfoPeer peer = charinfo::FromPublish(msg.publish());
-			charinfo::GetPeers()[sender] = std::make_shared<charinfo::CharinfoPeer>(std::move(peer));
+			peer.channel = channel;
+			if (!known && peer.version < charinfo::CHARINFO_VERSION && channel == s_homeChannel)
+				s_compatPublishPending = true;
+			auto snapshot = std::make_shared<charinfo::CharinfoPeer>(std::move(peer));
+			if (it != peers.end())
+				it->second = std::move(snapshot);
+			else
+				peers.emplace(sender, std::move(snapshot));
 		}
 		return;
 	}
 
 	if (msg.id() == Id::Update && msg.has_update()) {
-		const auto& update = msg.update();
-		const std::string& sender = update.sender();
-		if (sender.empty())
-			return;
-		auto it = charinfo::GetPeers().find(sender);
-		if (it == charinfo::GetPeers().end())
+		auto& update = *msg.mutable_update();
+		if (update.relay() && IsHub() && !update.sender().empty()) {
+			// Forwarded as sent: receivers resolve the sender's tokens themselves.
+			auto* relayed = s_hubBatch.add_updates();
+			*relayed = update;
+			relayed->clear_relay();
+		}
+		ApplyUpdate(update, channel);
+		return;
+	}
+
+	if (msg.id() == Id::Batch && msg.has_batch()) {
+		auto& batch = *msg.mutable_batch();
+		if (batch.sender().empty() || batch.sender() == s_current.sender())
 			return;
-		for (int i = 0; i < update.updates_size(); i++)
-			charinfo::ApplyFieldUpdate(update.updates(i), it->second.get());
+		s_hubHeardMs[batch.sender()] = charinfo::ClockMs();
+		// Priority updates first. Everything a sender relayed after one of its bulk updates waits
+		// with it, so each sender's updates are still applied in sequence.
+		auto& updates = *batch.mutable_updates();
+		for (int i = 0; i < updates.size(); i++) {
+			auto& update = updates[i];
+			if (update.sender() == s_current.sender()) {
+				if (static_cast<int32_t>(update.seq() - s_lastRelayedSeq) > 0)
+					s_lastRelayedSeq = update.seq();
+				continue;
+			}
+			const bool behindBulk = std::find(s_deferredSenders.begin(), s_deferredSenders.end(), update.sender()) != s_deferredSenders.end();
+			if (update.bulk() || behindBulk) {
+				s_deferredUpdates.push_back(i);
+				if (!behindBulk)
+					s_deferredSenders.push_back(update.sender());
+				continue;
+			}
+			if (!s_deferredUpdates.empty())
+				charinfo::GetPublishStats().priority_applied_first++;
+			ApplyUpdate(update, channel);
+		}
+		for (int i : s_deferredUpdates)
+			ApplyUpdate(updates[i], channel);
+		s_deferredUpdates.clear();
+		s_deferredSenders.clear();
 		return;
 	}
 
@@ -70,65 +471,715 @@ static void HandleMessage(const std::shared_ptr<postoffice::Message>& message)
 				it->second->set_invalidated(true);
 				charinfo::GetPeers().erase(it);
 			}
+			s_subscriptions.erase(sender);
+			s_hubHeardMs.erase(sender);
+			s_pendingJoinReplies.erase(std::remove_if(s_pendingJoinReplies.begin(), s_pendingJoinReplies.end(),
+				[&sender](const PendingJoinReply& reply) { return reply.joiner == sender; }), s_pendingJoinReplies.end());
 		}
 		return;
 	}
 
+	const bool home = channel == s_homeChannel;
+
 	if (msg.id() == Id::Joined && msg.has_joined()) {
+		if (!home)
+			return;
 		const std::string& joinedSender = msg.joined().sender();
 		if (pLocalPlayer && joinedSender == pLocalPlayer->DisplayedName)
 			return;
+		// Our own full publish goes out as soon as we initialize.
+		if (!s_initialized)
+			return;
+
+		// Answered from OnPulse once the jitter delay has passed, together with any other joiners.
+		uint32_t seq = 0;
+		uint64_t checksum = 0;
+		for (const auto& known : msg.joined().known()) {
+			if (known.sender() == s_current.sender()) {
+				seq = known.seq();
+				checksum = known.checksum();
+				break;
+			}
+		}
+		QueueJoinReply(joinedSender, seq, checksum);
+		return;
+	}
+
+	if (msg.id() == Id::Subscribe && msg.has_subscribe()) {
+		const std::string& sender = msg.subscribe().sender();
+		if (home && !sender.empty())
+			s_subscriptions[sender] = { msg.subscribe().sections(), charinfo::ClockMs(), msg.subscribe().hub_candidate() };
+		return;
+	}
+
+	if (msg.id() == Id::Unchanged && msg.has_unchanged()) {
+		// The sender's snapshot is the version we advertised; anything else means we lost track.
+		const std::string& sender = msg.unchanged().sender();
+		auto it = charinfo::GetPeers().find(sender);
+		if (it == charinfo::GetPeers().end() || it->second->seq != msg.unchanged().seq())
+			SendResync(sender, channel);
+		return;
+	}
 
-		mq::proto::charinfo::CharinfoPublish payload;
-		if (!charinfo::BuildPublishPayload(&payload))
+	if (msg.id() == Id::Resync && msg.has_resync()) {
+		const std::string& requester = msg.resync().sender();
+		if (!home || !s_initialized || requester.empty())
 			return;
-		mq::proto::charinfo::CharinfoMessage replyMsg;
-		replyMsg.set_id(mq::proto::charinfo::CharinfoMessageId::Publish);
-		*replyMsg.mutable_publish() = payload;
-		postoffice::Address address;
-		address.Server = GetServerShortName();
-		address.Mailbox = "charinfo";
-		s_charinfoDropbox.Post(address, replyMsg);
+		SendFullPublish(&s_current, requester);
+		charinfo::GetPublishStats().resync_replies++;
 	}
 }
 
-static void SendFullPublish(const mq::proto::charinfo::CharinfoPublish& payload)
+static void HandleMessage(const std::shared_ptr<postoffice::Message>& message, const std::string& channel)
 {
-	mq::proto::charinfo::CharinfoMessage msg;
-	msg.set_id(mq::proto::charinfo::CharinfoMessageId::Publish);
-	*msg.mutable_publish() = payload;
+	const auto start = std::chrono::steady_clock::now();
+	DispatchMessage(message, channel);
+	charinfo::PublishStats& stats = charinfo::GetPublishStats();
+	stats.received_messages++;
+	stats.receive_us += static_cast<uint64_t>(
+		std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+}
+
+// Outbound messages are built in place on a frame arena that is reset after each Post. The
+// initial block is static and survives Reset, so steady-state sends never touch the heap.
+static google::protobuf::ArenaOptions FrameArenaOptions()
+{
+	alignas(16) static char s_frameBlock[16 * 1024];
+	google::protobuf::ArenaOptions options;
+	options.initial_block = s_frameBlock;
+	options.initial_block_size = sizeof(s_frameBlock);
+	return options;
+}
+
+static google::protobuf::Arena& FrameArena()
+{
+	static google::protobuf::Arena s_arena(FrameArenaOptions());
+	return s_arena;
+}
+
+static mq::proto::charinfo::CharinfoMessage* NewFrameMessage(mq::proto::charinfo::CharinfoMessageId id)
+{
+	auto* msg = google::protobuf::Arena::CreateMessage<mq::proto::charinfo::CharinfoMessage>(&FrameArena());
+	msg->set_id(id);
+	return msg;
+}
+
+// Swap the serialized message in the wire buffer for a compressed envelope when that is smaller.
+// Only the message id stays readable outside the compressed body. The trained dictionary is used
+// once every peer can decode it.
+static void CompressWireBuffer(mq::proto::charinfo::CharinfoMessageId id)
+{
+	const auto kind = charinfo::MinPeerVersion() >= charinfo::CHARINFO_VERSION_TRAINED_DICTIONARY
+		? mq::proto::charinfo::COMPRESSION_ZSTD_DICT_V2 : mq::proto::charinfo::COMPRESSION_ZSTD_DICT_V1;
+	if (!charinfo::CompressPayload(s_wireBuffer, &s_compressBuffer, kind))
+		return;
+	auto* envelope = NewFrameMessage(id);
+	envelope->set_compression(kind);
+	envelope->mutable_compressed()->swap(s_compressBuffer);
+	envelope->SerializeToString(&s_wireBuffer);
+	envelope->mutable_compressed()->swap(s_compressBuffer);
+}
+
+// Post an already serialized message on `channel` to `recipient`, or to everyone there when it is empty.
+static void PostWireOn(const std::string& channel, const std::string& recipient, const std::string& wire)
+{
+	if (recipient.empty())
+		s_transport->Broadcast(channel, wire);
+	else
+		s_transport->Send(recipient, channel, wire);
+
+	charinfo::PublishStats& stats = charinfo::GetPublishStats();
+	stats.messages++;
+	stats.bytes += wire.size();
+}
+
+// Post an already serialized message on our home channel: our own state, and anything addressed to
+// a reader of it, whichever channel that reader belongs to.
+static void PostWire(const std::string& recipient, const std::string& wire)
+{
+	PostWireOn(s_homeChannel, recipient, wire);
+}
+
+static void CapturePublish(const std::string& sender, const std::string& wire)
+{
+	if (s_captureDir.empty() || s_capturedPublishes >= s_maxCapturedPublishes)
+		return;
+	const std::string path = s_captureDir + "/publish_" + sender + "_" + std::to_string(s_capturedPublishes++) + ".bin";
+	std::ofstream(path, std::ios::binary).write(wire.data(), static_cast<std::streamsize>(wire.size()));
+}
+
+// Serialize into the reused wire buffer and post to `recipient` (empty = every peer).
+static void PostTo(const std::string& recipient, const mq::proto::charinfo::CharinfoMessage& msg, bool compress = false)
+{
+	msg.SerializeToString(&s_wireBuffer);
+	if (msg.id() == mq::proto::charinfo::CharinfoMessageId::Publish)
+		CapturePublish(msg.publish().sender(), s_wireBuffer);
+	if (compress)
+		CompressWireBuffer(msg.id());
+	PostWire(recipient, s_wireBuffer);
+}
+
+// Post to every member and listener of our home channel on this server.
+static void PostToServer(const mq::proto::charinfo::CharinfoMessage& msg, bool compress = false)
+{
+	PostTo(std::string(), msg, compress);
+}
+
+// Post to our home channel and every channel we listen to (joins, leaves and subscriptions).
+static void PostToChannels(const mq::proto::charinfo::CharinfoMessage& msg)
+{
+	PostToServer(msg);
+	for (const ListenedChannel& listened : s_listenedChannels)
+		PostWireOn(listened.name, std::string(), s_wireBuffer);
+}
+
+// Post to one character's mailbox for our home channel on this server.
+static void PostToCharacter(const std::string& character, const mq::proto::charinfo::CharinfoMessage& msg, bool compress = false)
+{
+	PostTo(character, msg, compress);
+}
+
+// Broadcast the snapshot, or send it to `recipient` alone (resync replies).
+static void SendFullPublish(mq::proto::charinfo::CharinfoPublish* payload, const std::string& recipient)
+{
+	auto* msg = NewFrameMessage(mq::proto::charinfo::CharinfoMessageId::Publish);
+	payload->set_clock_ms(charinfo::ClockMs());
+	payload->set_seq(s_seq);
+	const float peerVersion = charinfo::MinPeerVersion();
+	const bool compress = s_compression && peerVersion >= charinfo::CHARINFO_VERSION_COMPRESSION;
+	// Receivers rebuild their string table for us from this publish. A broadcast restarts every
+	// table; one addressed to a single peer must not redefine strings the others never saw.
+	if (peerVersion < charinfo::CHARINFO_VERSION_SESSION_STRINGS)
+		s_sessionStrings.Undefine();
+	else if (recipient.empty())
+		s_sessionStrings.Keyframe(payload);
+	else
+		s_sessionStrings.Carry(payload);
+	const auto post = [&]() {
+		if (recipient.empty())
+			PostToServer(*msg, compress);
+		else
+			PostToCharacter(recipient, *msg, compress);
+	};
+	if (peerVersion < charinfo::CHARINFO_VERSION_COMPACT_SPELLS) {
+		// Pre-1.8 receivers need spell names: expand a frame copy and leave the compact snapshot alone.
+		*msg->mutable_publish() = *payload;
+		charinfo::ExpandSpellInfos(msg->mutable_publish());
+		post();
+	} else {
+		// Borrow the snapshot instead of copying it; it is handed back before the frame is released.
+		msg->unsafe_arena_set_allocated_publish(payload);
+		post();
+		msg->unsafe_arena_release_publish();
+	}
+	payload->clear_string_tokens();
+	FrameArena().Reset();
+	if (recipient.empty()) {
+		// Everyone has our snapshot now, including pending joiners.
+		s_compatPublishPending = false;
+		s_pendingJoinReplies.clear();
+		s_lastRelayedSeq = s_seq;
+	}
+	charinfo::GetPublishStats().full_publishes++;
+}
+
+static void SendUnchanged(const std::string& joiner)
+{
+	auto* msg = NewFrameMessage(mq::proto::charinfo::CharinfoMessageId::Unchanged);
+	msg->mutable_unchanged()->set_sender(s_current.sender());
+	msg->mutable_unchanged()->set_seq(s_seq);
+	PostToCharacter(joiner, *msg);
+	FrameArena().Reset();
+}
+
+// Re-send the updates after `seq` to `joiner`, if it holds our snapshot as of that update and
+// every later update is still in the history.
+static bool ReplayUpdates(const std::string& joiner, uint32_t seq, uint64_t checksum)
+{
+	const uint32_t behind = s_seq - seq;
+	if (behind == 0 || behind >= s_sentUpdateHistory)
+		return false;
+	const SentUpdate& base = s_sentUpdates[seq % s_sentUpdateHistory];
+	if (base.seq != seq || base.checksum != checksum)
+		return false;
+	for (uint32_t i = 1; i <= behind; i++) {
+		if (s_sentUpdates[(seq + i) % s_sentUpdateHistory].seq != seq + i)
+			return false;
+	}
+
+	for (uint32_t i = 1; i <= behind; i++)
+		PostWire(joiner, s_sentUpdates[(seq + i) % s_sentUpdateHistory].wire);
+	charinfo::GetPublishStats().replayed_updates += behind;
+	return true;
+}
+
+// Answer the joiners queued since the first one's jitter delay started: "unchanged" or a replay
+// when they advertised a version we can still serve, the current snapshot otherwise. The snapshot
+// matches the last published one in every diffed field and carries fresh buff durations for
+// pre-1.6 receivers.
+static void FlushJoinReplies()
+{
+	if (s_pendingJoinReplies.empty() || charinfo::ClockMs() < s_joinReplyAtMs)
+		return;
 
-	postoffice::Address address;
-	address.Server = GetServerShortName();
-	address.Mailbox = "charinfo";
+	std::vector<PendingJoinReply> pending;
+	pending.swap(s_pendingJoinReplies);
+	charinfo::PublishStats& stats = charinfo::GetPublishStats();
+	std::vector<const std::string*> needFull;
+	for (const PendingJoinReply& reply : pending) {
+		if (reply.checksum != 0 && reply.seq == s_seq && reply.checksum == s_lastPublishedChecksum) {
+			SendUnchanged(reply.joiner);
+			stats.join_replies_unchanged++;
+		} else if (reply.checksum != 0 && ReplayUpdates(reply.joiner, reply.seq, reply.checksum)) {
+			stats.join_replies_replayed++;
+		} else {
+			needFull.push_back(&reply.joiner);
+		}
+	}
+	if (needFull.empty())
+		return;
 
-	s_charinfoDropbox.Post(address, msg);
+	if (charinfo::BroadcastJoinReplies(needFull.size(), charinfo::GetPeers().size())) {
+		SendFullPublish(&s_current);
+		stats.join_reply_broadcasts++;
+	} else {
+		for (const std::string* joiner : needFull)
+			SendFullPublish(&s_current, *joiner);
+		stats.join_replies_directed += needFull.size();
+	}
 }
 
+// Ask `sender`, a member of `channel`, for a full publish addressed to us, at most once per
+// s_resyncIntervalMs.
+static void SendResync(const std::string& sender, const std::string& channel)
+{
+	if (s_current.sender().empty())
+		return;
+	const int64_t now = charinfo::ClockMs();
+	auto it = s_resyncRequestedAt.find(sender);
+	if (it != s_resyncRequestedAt.end() && now - it->second < s_resyncIntervalMs)
+		return;
+	s_resyncRequestedAt[sender] = now;
+
+	auto* msg = NewFrameMessage(mq::proto::charinfo::CharinfoMessageId::Resync);
+	msg->mutable_resync()->set_sender(s_current.sender());
+	msg->SerializeToString(&s_wireBuffer);
+	PostWireOn(channel, sender, s_wireBuffer);
+	FrameArena().Reset();
+	charinfo::GetPublishStats().resync_requests++;
+}
+
+// Advertise the sections we read when that set changes, and periodically so senders can tell
+// we are still around.
+static void UpdateSubscription()
+{
+	const charinfo::SectionMask sections = charinfo::RecentlyReadSections(s_readDecayMs) | s_requiredSections;
+	const int64_t now = charinfo::ClockMs();
+	if (sections == s_advertisedSections && now - s_lastSubscribeMs < s_subscribeKeepaliveMs)
+		return;
+
+	auto* msg = NewFrameMessage(mq::proto::charinfo::CharinfoMessageId::Subscribe);
+	msg->mutable_subscribe()->set_sender(s_current.sender());
+	msg->mutable_subscribe()->set_sections(sections);
+	msg->mutable_subscribe()->set_hub_candidate(s_hubCandidate);
+	PostToChannels(*msg);
+	FrameArena().Reset();
+	s_advertisedSections = sections;
+	s_lastSubscribeMs = now;
+}
+
+// Announce ourselves, advertising the snapshot version we hold for each peer so they can answer
+// with "unchanged" or the updates we missed.
 static void SendJoined(const std::string& sender)
 {
-	mq::proto::charinfo::CharinfoMessage msg;
-	msg.set_id(mq::proto::charinfo::CharinfoMessageId::Joined);
-	msg.mutable_joined()->set_sender(sender);
+	auto* msg = NewFrameMessage(mq::proto::charinfo::CharinfoMessageId::Joined);
+	auto* joined = msg->mutable_joined();
+	joined->set_sender(sender);
+	for (const auto& [name, peer] : charinfo::GetPeers()) {
+		if (!peer || peer->seq == 0 || name == sender)
+			continue;
+		auto* known = joined->add_known();
+		known->set_sender(name);
+		known->set_seq(peer->seq);
+		known->set_checksum(charinfo::StateChecksum(*peer));
+	}
+	PostToChannels(*msg);
+	FrameArena().Reset();
+}
+
+// Pack the scalar fields of an update, recording bytes against the FieldUpdate framing they replace.
+static void PackUpdate(mq::proto::charinfo::CharinfoUpdate* update)
+{
+	size_t framedBytes = 0;
+	for (const auto& field : update->updates())
+		framedBytes += field.ByteSizeLong() + 2; // tag + length of each repeated entry
+
+	const auto start = std::chrono::steady_clock::now();
+	const int packed = charinfo::PackScalarUpdates(update);
+	const auto elapsed = std::chrono::steady_clock::now() - start;
+	if (packed == 0)
+		return;
 
-	postoffice::Address address;
-	address.Server = GetServerShortName();
-	address.Mailbox = "charinfo";
+	for (const auto& field : update->updates())
+		framedBytes -= field.ByteSizeLong() + 2;
+	charinfo::PublishStats& stats = charinfo::GetPublishStats();
+	stats.packed_updates++;
+	stats.packed_fields += packed;
+	stats.packed_bytes += update->packed().size();
+	stats.packed_field_update_bytes += framedBytes;
+	stats.pack_ns += static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+}
 
-	s_charinfoDropbox.Post(address, msg);
+static bool CheckpointDue()
+{
+	return s_updatesSinceCheckpoint >= s_checkpointUpdates || charinfo::ClockMs() >= s_nextCheckpointMs;
 }
 
-static void SendUpdate(const mq::proto::charinfo::CharinfoUpdate& update)
+// Pack and tokenize a built update for what every peer can read.
+static void EncodeUpdate(mq::proto::charinfo::CharinfoUpdate* update, float peerVersion)
 {
-	mq::proto::charinfo::CharinfoMessage msg;
-	msg.set_id(mq::proto::charinfo::CharinfoMessageId::Update);
-	*msg.mutable_update() = update;
+	if (peerVersion >= charinfo::CHARINFO_VERSION_PACKED_UPDATES)
+		PackUpdate(update);
+	if (peerVersion >= charinfo::CHARINFO_VERSION_SESSION_STRINGS)
+		s_sessionStrings.Tokenize(update);
+}
+
+// Sequence, route and record the update in s_updateMessage, then clear it. `checksum` is the
+// StateChecksum of our snapshot once the update is applied (0 for a bulk piece that leaves it part-way).
+static void PostUpdate(bool checkpoint, uint64_t checksum)
+{
+	s_updateMessage.set_id(mq::proto::charinfo::CharinfoMessageId::Update);
+	auto* update = s_updateMessage.mutable_update();
+	update->set_sender(s_current.sender());
+	update->set_clock_ms(charinfo::ClockMs());
+	update->set_seq(s_seq == UINT32_MAX ? 1 : s_seq + 1);
+	charinfo::PublishStats& stats = charinfo::GetPublishStats();
+	if (checkpoint) {
+		update->set_checkpoint(s_lastPublishedChecksum);
+		s_updatesSinceCheckpoint = 0;
+		s_nextCheckpointMs = charinfo::ClockMs() + s_checkpointIntervalMs;
+		stats.checkpoints_sent++;
+	} else {
+		s_updatesSinceCheckpoint++;
+	}
+	const charinfo::UpdateRoute route = charinfo::RouteUpdate(RemotePeers(), s_hub, s_current.sender());
+	if (route == charinfo::UpdateRoute::Hub)
+		update->set_relay(true);
+	s_updateMessage.SerializeToString(&s_wireBuffer);
+	if (charinfo::PostRoutedUpdate(*s_transport, route, s_homeChannel, s_hub, s_wireBuffer)) {
+		stats.messages++;
+		stats.bytes += s_wireBuffer.size();
+	}
+	switch (route) {
+	case charinfo::UpdateRoute::Hub:
+		stats.hub_relayed_updates++;
+		// The history keeps the update as broadcast: replays and re-sends after a failover must not
+		// ask another hub to batch it again.
+		update->clear_relay();
+		s_updateMessage.SerializeToString(&s_wireBuffer);
+		break;
+	case charinfo::UpdateRoute::HubBatch:
+		*s_hubBatch.add_updates() = *update;
+		s_lastRelayedSeq = update->seq();
+		break;
+	default:
+		// Broadcast, or kept for replays only while every peer reads our shared-memory slot.
+		s_lastRelayedSeq = update->seq();
+		break;
+	}
+	s_seq = update->seq();
+	stats.updates++;
+
+	SentUpdate& sent = s_sentUpdates[s_seq % s_sentUpdateHistory];
+	sent.seq = s_seq;
+	sent.checksum = checksum;
+	sent.wire = s_wireBuffer;
+	update->Clear();
+}
+
+// Diff the dirty sections and send them, syncing only those sections of the last-published
+// snapshot. A checkpoint goes out even when nothing changed. When the bulk-lane fields would push
+// the update past s_bulkMessageBytes, the priority lane goes first on its own and the bulk fields
+// follow in pieces; the checkpoint rides on the last piece.
+static void SendUpdate(charinfo::SectionMask dirty, bool checkpoint)
+{
+	const float peerVersion = charinfo::MinPeerVersion();
+	const charinfo::SectionMask priority = dirty & s_priorityLane;
+	const charinfo::SectionMask bulk = dirty & ~s_priorityLane;
+	auto* update = s_updateMessage.mutable_update();
+	const bool priorityChanged = priority != 0
+		&& charinfo::BuildUpdatePayload(s_current, s_lastPublished, update, priority, peerVersion)
+		&& update->updates_size() > 0;
+	const bool bulkChanged = bulk != 0
+		&& charinfo::BuildUpdatePayload(s_current, s_lastPublished, &s_bulkUpdate, bulk, peerVersion)
+		&& s_bulkUpdate.updates_size() > 0;
+	const size_t cap = static_cast<size_t>(s_bulkMessageBytes);
+
+	if (!bulkChanged || update->ByteSizeLong() + s_bulkUpdate.ByteSizeLong() <= cap) {
+		if (!priorityChanged && !bulkChanged && !checkpoint) {
+			update->Clear();
+			s_bulkUpdate.Clear();
+			return;
+		}
+		for (auto& field : *s_bulkUpdate.mutable_updates())
+			*update->add_updates() = std::move(field);
+		s_bulkUpdate.Clear();
+		if (priorityChanged || bulkChanged) {
+			EncodeUpdate(update, peerVersion);
+			charinfo::CopySections(s_current, &s_lastPublished, dirty);
+			s_lastPublishedChecksum = charinfo::StateChecksum(s_lastPublished);
+			s_sharedDirtySections |= dirty;
+		}
+		PostUpdate(checkpoint, s_lastPublishedChecksum);
+		return;
+	}
+
+	charinfo::PublishStats& stats = charinfo::GetPublishStats();
+	if (priorityChanged) {
+		EncodeUpdate(update, peerVersion);
+		charinfo::CopySections(s_current, &s_lastPublished, priority);
+		s_lastPublishedChecksum = charinfo::StateChecksum(s_lastPublished);
+		PostUpdate(false, s_lastPublishedChecksum);
+		stats.priority_updates++;
+	} else {
+		update->Clear();
+	}
+
+	auto& fields = *s_bulkUpdate.mutable_updates();
+	const int count = fields.size();
+	for (int first = 0; first < count;) {
+		// Field bytes plus the tag and length that frame each one; a field over the cap goes alone.
+		size_t bytes = 0;
+		int last = first;
+		for (; last < count; ++last) {
+			const size_t size = fields.Get(last).ByteSizeLong() + 3;
+			if (last > first && bytes + size > cap)
+				break;
+			bytes += size;
+		}
+		if (bytes > cap)
+			stats.bulk_oversized_fields++;
+
+		auto* piece = s_updateMessage.mutable_update();
+		piece->set_bulk(true);
+		for (int i = first; i < last; ++i)
+			*piece->add_updates() = std::move(*fields.Mutable(i));
+		EncodeUpdate(piece, peerVersion);
+		const bool lastPiece = last == count;
+		if (lastPiece) {
+			charinfo::CopySections(s_current, &s_lastPublished, bulk);
+			s_lastPublishedChecksum = charinfo::StateChecksum(s_lastPublished);
+		}
+		PostUpdate(lastPiece && checkpoint, lastPiece ? s_lastPublishedChecksum : 0);
+		stats.bulk_updates++;
+		stats.bulk_bytes += bytes;
+		first = last;
+	}
+	s_bulkUpdate.Clear();
+	s_sharedDirtySections |= dirty;
+}
+
+// The candidate with the lowest name among us and the members of our channel advertising candidacy,
+// skipping hubs that went quiet. Empty (everyone broadcasts) while any peer predates hub mode.
+static std::string ElectHub()
+{
+	if (charinfo::GetPeers().empty() || charinfo::MinPeerVersion() < charinfo::CHARINFO_VERSION_HUB)
+		return std::string();
+	const int64_t now = charinfo::ClockMs();
+	std::string hub = s_hubCandidate ? s_current.sender() : std::string();
+	for (const auto& [name, subscription] : s_subscriptions) {
+		if (!subscription.hub_candidate || name == s_current.sender())
+			continue;
+		auto peer = charinfo::GetPeers().find(name);
+		if (peer == charinfo::GetPeers().end() || !peer->second || peer->second->channel != s_homeChannel)
+			continue;
+		auto failed = s_hubFailedUntil.find(name);
+		if (failed != s_hubFailedUntil.end() && failed->second > now)
+			continue;
+		if (hub.empty() || name < hub)
+			hub = name;
+	}
+	return hub;
+}
+
+// Re-broadcast our updates the previous hub may not have forwarded. Updates already gone from the
+// history are left to the receivers' gap detection.
+static void ResendUnrelayed()
+{
+	const uint32_t missing = s_seq - s_lastRelayedSeq;
+	if (missing == 0 || missing > s_sentUpdateHistory) {
+		s_lastRelayedSeq = s_seq;
+		return;
+	}
+	for (uint32_t seq = s_lastRelayedSeq + 1, n = 0; n < missing; ++seq, ++n) {
+		const SentUpdate& sent = s_sentUpdates[seq % s_sentUpdateHistory];
+		if (sent.seq != seq || sent.wire.empty())
+			continue;
+		PostWire(std::string(), sent.wire);
+		charinfo::GetPublishStats().hub_resent_updates++;
+	}
+	s_lastRelayedSeq = s_seq;
+}
+
+static void FlushHubBatch()
+{
+	const int count = s_hubBatch.updates_size();
+	auto* msg = NewFrameMessage(mq::proto::charinfo::CharinfoMessageId::Batch);
+	s_hubBatch.set_sender(s_current.sender());
+	msg->unsafe_arena_set_allocated_batch(&s_hubBatch);
+	PostToServer(*msg, s_compression && charinfo::MinPeerVersion() >= charinfo::CHARINFO_VERSION_COMPRESSION);
+	msg->unsafe_arena_release_batch();
+	FrameArena().Reset();
+	s_hubBatch.Clear();
+	s_lastBatchMs = charinfo::ClockMs();
+
+	charinfo::PublishStats& stats = charinfo::GetPublishStats();
+	stats.hub_batches++;
+	stats.hub_batched_updates += static_cast<uint64_t>(count);
+}
+
+// Per pulse: fail over from a quiet hub, follow the election, and flush our batch when we are the hub.
+static void UpdateHub()
+{
+	const int64_t now = charinfo::ClockMs();
+	if (!s_hub.empty() && !IsHub()) {
+		auto heard = s_hubHeardMs.find(s_hub);
+		const int64_t lastHeard = std::max(s_hubElectedMs, heard == s_hubHeardMs.end() ? 0 : heard->second);
+		if (now - lastHeard > s_hubTimeoutMs) {
+			s_hubFailedUntil[s_hub] = now + s_hubRetryMs;
+			charinfo::GetPublishStats().hub_failovers++;
+		}
+	}
+
+	std::string hub = ElectHub();
+	if (hub != s_hub) {
+		if (IsHub())
+			FlushHubBatch();
+		else if (!s_hub.empty())
+			ResendUnrelayed();
+		s_hub = std::move(hub);
+		s_hubElectedMs = now;
+	}
+
+	if (IsHub()) {
+		const int64_t interval = s_hubBatch.updates_size() > 0 ? s_hubIntervalMs : s_hubHeartbeatMs;
+		if (now - s_lastBatchMs >= interval)
+			FlushHubBatch();
+	}
+}
+
+static bool SameZoneIdentity(const mq::proto::charinfo::ZoneInfo& a, const mq::proto::charinfo::ZoneInfo& b)
+{
+	return a.id() == b.id() && a.instance_id() == b.instance_id()
+		&& a.name() == b.name() && a.short_name() == b.short_name();
+}
+
+// Send a position-only Zone change. Directed posts to same-zone peers are used while those are
+// fewer than the peers elsewhere; past that, a broadcast costs less than the posts it replaces.
+static void SendPositionUpdate()
+{
+	auto* msg = NewFrameMessage(mq::proto::charinfo::CharinfoMessageId::Update);
+	auto* update = msg->mutable_update();
+	update->set_sender(s_current.sender());
+	update->set_clock_ms(charinfo::ClockMs());
+	const charinfo::SectionMask zone = charinfo::SectionBit(charinfo::PublishSection::Zone);
+	if (!charinfo::BuildUpdatePayload(s_current, s_lastPublished, update, zone, charinfo::MinPeerVersion())
+		|| update->updates_size() == 0) {
+		FrameArena().Reset();
+		return;
+	}
+	charinfo::CopySections(s_current, &s_lastPublished, zone);
+	s_sharedDirtySections |= zone;
+	if (!RemotePeers()) {
+		FrameArena().Reset();
+		return;
+	}
+
+	std::vector<const std::string*> sameZone;
+	size_t elsewhere = 0;
+	for (const auto& [name, peer] : charinfo::GetPeers()) {
+		if (!peer || name == s_current.sender() || peer->shared_memory || peer->channel != s_homeChannel)
+			continue;
+		if (peer->zone.id == s_current.zone().id() && peer->zone.instance_id == s_current.zone().instance_id())
+			sameZone.push_back(&name);
+		else
+			elsewhere++;
+	}
+
+	const int64_t now = charinfo::ClockMs();
+	charinfo::PublishStats& stats = charinfo::GetPublishStats();
+	stats.position_updates++;
+	if (elsewhere == 0 || sameZone.size() >= elsewhere || now - s_lastPositionBroadcastMs >= s_crossZonePositionMs) {
+		PostToServer(*msg);
+		s_lastPositionBroadcastMs = now;
+		stats.position_broadcasts++;
+	} else {
+		msg->SerializeToString(&s_wireBuffer);
+		for (const std::string* name : sameZone)
+			PostWire(*name, s_wireBuffer);
+		stats.position_directed_posts += sameZone.size();
+	}
+	FrameArena().Reset();
+}
+
+// Write our snapshot after a send (touch the slot otherwise), then take in the snapshots other
+// local clients wrote since the last pulse. A send that changed only vitals and target rewrites
+// just the slot's vitals, and a reader applies those to its copy without parsing anything.
+static void UpdateSharedSnapshots()
+{
+	if (!s_sharedSnapshots.IsOpen())
+		return;
+	const int64_t now = charinfo::ClockMs();
+	const bool touch = now - s_sharedTouchMs >= s_sharedTouchIntervalMs;
+	charinfo::PublishStats& stats = charinfo::GetPublishStats();
+	if (s_sharedDirtySections != 0) {
+		s_lastPublished.set_seq(s_seq);
+		s_lastPublished.set_clock_ms(now);
+		const bool vitalsFit = charinfo::ToSharedVitals(s_lastPublished, &s_sharedVitals);
+		if (vitalsFit && (s_sharedDirtySections & ~s_sharedVitalsSections) == 0
+			&& s_sharedSnapshots.WriteVitals(s_sharedVitals, now)) {
+			stats.shared_vitals_writes++;
+		} else {
+			s_lastPublished.SerializeToString(&s_sharedBuffer);
+			// With a target name too long for the vitals, readers take it from the snapshot.
+			if (!s_sharedSnapshots.Write(s_current.sender(), s_sharedBuffer, s_sharedVitals, now))
+				stats.shared_snapshot_write_failures++;
+		}
+		s_sharedDirtySections = 0;
+		s_sharedTouchMs = now;
+	} else if (touch) {
+		s_sharedSnapshots.Touch(now);
+		s_sharedTouchMs = now;
+	}
 
-	postoffice::Address address;
-	address.Server = GetServerShortName();
-	address.Mailbox = "charinfo";
+	s_sharedSnapshots.ReadChanged(s_current.sender(), now, [&stats](const std::string& character, const std::string* bytes,
+		const charinfo::SharedVitals& vitals) {
+		if (!bytes) {
+			// Only the vitals changed: patch the copy we read from the slot before.
+			auto it = charinfo::GetPeers().find(character);
+			if (it == charinfo::GetPeers().end() || !it->second || !it->second->shared_memory)
+				return false;
+			charinfo::ApplySharedVitals(vitals, it->second.get());
+			stats.shared_vitals_read++;
+			return true;
+		}
+		if (!s_sharedPublish.ParseFromString(*bytes) || s_sharedPublish.sender() != character)
+			return true;
+		charinfo::CharinfoPeer peer = charinfo::FromPublish(s_sharedPublish);
+		peer.shared_memory = true;
+		peer.channel = s_homeChannel;
+		charinfo::GetPeers()[character] = std::make_shared<charinfo::CharinfoPeer>(std::move(peer));
+		stats.shared_snapshots_read++;
+		return true;
+	});
 
-	s_charinfoDropbox.Post(address, msg);
+	if (touch) {
+		// A slot that went quiet: back to postoffice, where the next update's gap asks for a resync.
+		for (auto& [name, peer] : charinfo::GetPeers()) {
+			if (peer && peer->shared_memory && !s_sharedSnapshots.IsLive(name, now))
+				peer->shared_memory = false;
+		}
+	}
 }
 
 static void SendRemove()
@@ -136,20 +1187,135 @@ static void SendRemove()
 	if (!pLocalPlayer)
 		return;
 
-	mq::proto::charinfo::CharinfoMessage msg;
-	msg.set_id(mq::proto::charinfo::CharinfoMessageId::Remove);
-	msg.mutable_remove()->set_sender(pLocalPlayer->DisplayedName);
+	auto* msg = NewFrameMessage(mq::proto::charinfo::CharinfoMessageId::Remove);
+	msg->mutable_remove()->set_sender(pLocalPlayer->DisplayedName);
+	PostToChannels(*msg);
+	FrameArena().Reset();
+}
 
-	postoffice::Address address;
-	address.Server = GetServerShortName();
-	address.Mailbox = "charinfo";
+static std::string SharedRegionName()
+{
+	std::string name = std::string("MQCharinfo_") + GetServerShortName();
+	if (!s_homeChannel.empty())
+		name += "_" + s_homeChannel;
+	return name;
+}
 
-	s_charinfoDropbox.Post(address, msg);
+static postoffice::DropboxAPI OpenChannel(const std::string& channel)
+{
+	return postoffice::AddActor(ChannelMailbox(channel).c_str(),
+		[channel](const std::shared_ptr<postoffice::Message>& message) { HandleMessage(message, channel); });
+}
+
+static void CloseListenedChannels()
+{
+	for (ListenedChannel& listened : s_listenedChannels)
+		listened.dropbox.Remove();
+	s_listenedChannels.clear();
+}
+
+// The channel Channel=auto puts us on: the raid leader's while in a raid, else the group leader's,
+// else the default channel.
+static std::string AutoChannel()
+{
+	if (pRaid && pRaid->RaidMemberCount > 0 && pRaid->RaidLeaderName[0])
+		return std::string("raid_") + pRaid->RaidLeaderName;
+	if (pLocalPC && pLocalPC->pGroupInfo) {
+		if (CGroupMember* leader = pLocalPC->pGroupInfo->GetGroupLeader())
+			return std::string("group_") + leader->GetName();
+	}
+	return std::string();
+}
+
+// Move to another home channel: leave the old one, forget its members and its hub election, and
+// start over on the new one with a full publish and Joined. Members of the new channel we already
+// read as a listener are kept.
+static void SwitchHomeChannel(const std::string& channel)
+{
+	if (s_initialized)
+		SendRemove();
+	const std::string previous = s_homeChannel;
+	s_charinfoDropbox.Remove();
+	for (auto it = s_listenedChannels.begin(); it != s_listenedChannels.end();) {
+		if (it->name == channel) {
+			it->dropbox.Remove();
+			it = s_listenedChannels.erase(it);
+		} else {
+			++it;
+		}
+	}
+	s_homeChannel = channel;
+	s_charinfoDropbox = OpenChannel(channel);
+	s_postoffice.Reset();
+
+	auto& peers = charinfo::GetPeers();
+	for (auto it = peers.begin(); it != peers.end();) {
+		if (it->second && it->second->channel == previous) {
+			it->second->set_invalidated(true);
+			it = peers.erase(it);
+		} else {
+			++it;
+		}
+	}
+	s_subscriptions.clear();
+	s_advertisedSections = 0;
+	s_pendingJoinReplies.clear();
+	s_hub.clear();
+	s_hubBatch.Clear();
+	s_hubHeardMs.clear();
+	s_hubFailedUntil.clear();
+	if (s_sharedSnapshots.IsOpen()) {
+		s_sharedSnapshots.Open(SharedRegionName());
+		s_sharedDirtySections = charinfo::kAllSections;
+	}
+	s_initialized = false;
+}
+
+static void LoadChannels(const std::string& iniSection)
+{
+	char value[MAX_STRING] = {};
+	GetPrivateProfileString(iniSection.c_str(), "Channel", "", value, MAX_STRING, INIFileName);
+	std::string channel = value;
+	mq::trim(channel);
+	s_autoChannel = ci_equals(channel, "auto");
+	if (s_autoChannel)
+		channel = AutoChannel();
+	if (channel != s_homeChannel)
+		SwitchHomeChannel(channel);
+	s_channelCheckMs = charinfo::ClockMs();
+
+	CloseListenedChannels();
+	GetPrivateProfileString(iniSection.c_str(), "Listen", "", value, MAX_STRING, INIFileName);
+	for (std::string_view part : mq::split_view(value, ',', false)) {
+		std::string name(part);
+		mq::trim(name);
+		if (name.empty() || name == s_homeChannel)
+			continue;
+		if (std::any_of(s_listenedChannels.begin(), s_listenedChannels.end(),
+			[&name](const ListenedChannel& listened) { return listened.name == name; }))
+			continue;
+		s_listenedChannels.push_back({ name, OpenChannel(name) });
+	}
+}
+
+// Per pulse with Channel=auto: follow raid and group changes.
+static void UpdateChannel()
+{
+	if (!s_autoChannel)
+		return;
+	const int64_t now = charinfo::ClockMs();
+	if (now - s_channelCheckMs < s_channelCheckIntervalMs)
+		return;
+	s_channelCheckMs = now;
+	const std::string channel = AutoChannel();
+	if (channel != s_homeChannel) {
+		SwitchHomeChannel(channel);
+		charinfo::GetPublishStats().channel_switches++;
+	}
 }
 
 PLUGIN_API void InitializePlugin()
 {
-	s_nextPublish = std::chrono::steady_clock::now();
 	s_settingsPanelId = "plugins/" + mqplugin::ThisPlugin->name;
 	AddSettingsPanel(s_settingsPanelId.c_str(), DrawCharinfoPanel);
 }
@@ -160,15 +1326,17 @@ PLUGIN_API void ShutdownPlugin()
 	if (s_actorRegistered) {
 		SendRemove();
 		s_charinfoDropbox.Remove();
+		CloseListenedChannels();
 		s_actorRegistered = false;
 	}
+	s_sharedSnapshots.Close();
 }
 
 PLUGIN_API void SetGameState(int GameState)
 {
 	if (GameState == GAMESTATE_INGAME) {
 		if (!s_actorRegistered) {
-			s_charinfoDropbox = postoffice::AddActor("charinfo", HandleMessage);
+			s_charinfoDropbox = OpenChannel(s_homeChannel);
 			s_actorRegistered = true;
 		}
 	}
@@ -176,16 +1344,53 @@ PLUGIN_API void SetGameState(int GameState)
 		if (s_actorRegistered) {
 			SendRemove();
 			s_charinfoDropbox.Remove();
+			CloseListenedChannels();
 			s_actorRegistered = false;
 		}
+		s_autoChannel = false;
 		Initialized = false;
 		s_initialized = false;
+		s_sampler.Reset();
+		s_positionTracker.Reset();
+		s_sessionStrings.Reset();
+		s_current.Clear();
+		s_postoffice.Reset();
+		s_resyncRequestedAt.clear();
+		s_pendingJoinReplies.clear();
+		s_subscriptions.clear();
+		s_advertisedSections = 0;
+		s_hub.clear();
+		s_hubBatch.Clear();
+		s_hubHeardMs.clear();
+		s_hubFailedUntil.clear();
+		s_sharedSnapshots.Close();
+		s_sharedDirtySections = 0;
+		charinfo::InvalidateSpellCache();
 	}
 }
 
 PLUGIN_API void OnZoned()
 {
 	s_justZoned = true;
+	charinfo::InvalidateInventory();
+}
+
+// Chat lines that mean items entered or left the bags without passing through the cursor.
+static const char* const s_inventoryChangeMessages[] = {
+	"You have looted",
+	"You receive",
+	"You have fashioned",
+};
+
+PLUGIN_API bool OnIncomingChat(const char* Line, DWORD Color)
+{
+	for (const char* message : s_inventoryChangeMessages) {
+		if (strstr(Line, message)) {
+			charinfo::InvalidateInventory();
+			break;
+		}
+	}
+	return false;
 }
 
 PLUGIN_API void OnPulse()
@@ -197,32 +1402,104 @@ PLUGIN_API void OnPulse()
 
 	if (!Initialized) {
 		WriteChatf("[MQCharinfo]: Initialized. version %.2f", charinfo::CHARINFO_VERSION);
+		const std::string iniSection = std::string(GetServerShortName()) + "_" + pLocalPC->Name;
+		s_scheduler.LoadSettings(iniSection);
+		s_compression = GetPrivateProfileInt(iniSection.c_str(), "Compression", 0, INIFileName) != 0;
+		char captureDir[MAX_STRING] = {};
+		GetPrivateProfileString(iniSection.c_str(), "CaptureDir", "", captureDir, MAX_STRING, INIFileName);
+		s_captureDir = captureDir;
+		mq::trim(s_captureDir);
+		s_checkpointUpdates = std::max(1, static_cast<int>(GetPrivateProfileInt(iniSection.c_str(), "CheckpointUpdates", 100, INIFileName)));
+		s_checkpointIntervalMs = std::max(s_minCheckpointIntervalMs,
+			static_cast<int>(GetPrivateProfileInt(iniSection.c_str(), "CheckpointInterval", 30000, INIFileName)));
+		s_sessionStrings.Reset();
+		s_hubCandidate = GetPrivateProfileInt(iniSection.c_str(), "Hub", 0, INIFileName) != 0;
+		s_hubIntervalMs = std::max(s_minHubIntervalMs,
+			static_cast<int>(GetPrivateProfileInt(iniSection.c_str(), "HubInterval", 100, INIFileName)));
+		LoadChannels(iniSection);
+		if (GetPrivateProfileInt(iniSection.c_str(), "SharedMemory", 1, INIFileName) != 0)
+			s_sharedSnapshots.Open(SharedRegionName());
+		s_bulkMessageBytes = std::max(s_minBulkMessageBytes,
+			static_cast<int>(GetPrivateProfileInt(iniSection.c_str(), "BulkMessageBytes", 1024, INIFileName)));
+		s_positionThreshold = static_cast<float>(std::max(1, static_cast<int>(GetPrivateProfileInt(iniSection.c_str(), "PositionThreshold", 2, INIFileName))));
+		s_positionTracker.Reset();
+		s_updatesSinceCheckpoint = 0;
+		s_nextCheckpointMs = charinfo::ClockMs()
+			+ static_cast<int64_t>(std::hash<std::string>()(pLocalPC->Name) % static_cast<size_t>(s_checkpointIntervalMs));
+		charinfo::GetPublishStats() = charinfo::PublishStats();
+		charinfo::GetPublishStats().started_ms = charinfo::ClockMs();
+		charinfo::GetCompressionStats() = charinfo::CompressionStats();
+		charinfo::ResetSectionReads();
 		Initialized = true;
 		return;
 	}
 
-	auto now = std::chrono::steady_clock::now();
-	if (now < s_nextPublish)
-		return;
+	charinfo::NoteInventoryCursor();
+	UpdateChannel();
+
+	if (s_initialized && !s_justZoned) {
+		FlushJoinReplies();
+		UpdateSubscription();
+		UpdateHub();
+		UpdateSharedSnapshots();
+	}
+
+	if (!s_initialized || s_justZoned)
+		s_scheduler.ForceAll();
 
-	s_nextPublish = now + s_publishInterval;
+	const bool inCombat = pLocalPlayer && GetCombatState() == s_combatStateCombat;
+	const bool moving = pLocalPlayer && std::fabs(pLocalPlayer->SpeedRun) > 0.0f;
+	charinfo::SectionMask due = s_scheduler.Due(std::chrono::steady_clock::now(), inCombat, moving);
+	// Sections nobody reads are neither sampled nor sent; s_lastPublished keeps their last sent
+	// values, so checkpoints still match and sampling resumes with a diff once someone subscribes.
+	if (s_initialized && !s_justZoned)
+		due &= InterestMask();
+	const bool checkpoint = s_initialized && !s_justZoned && CheckpointDue();
+	if (due == 0 && !checkpoint)
+		return;
 
-	mq::proto::charinfo::CharinfoPublish payload;
-	if (!charinfo::BuildPublishPayload(&payload))
+	charinfo::SectionMask dirty = 0;
+	if (!s_sampler.Sample(&s_current, &dirty, due))
 		return;
 
-	if (!s_initialized || s_justZoned) {
-		SendFullPublish(payload);
-		SendJoined(payload.sender());
-		s_lastPublished = payload;
+	const charinfo::SectionMask zone = charinfo::SectionBit(charinfo::PublishSection::Zone);
+	if (due & zone) {
+		charinfo::PublishStats& stats = charinfo::GetPublishStats();
+		if (s_positionTracker.Update(&s_current, charinfo::ClockMs(), s_positionThreshold)) {
+			stats.position_fixes++;
+			dirty |= zone;
+		} else if (dirty & zone) {
+			stats.position_predicted++;
+			// Peers that extrapolate our last fix need nothing while it still predicts us.
+			if (charinfo::MinPeerVersion() >= charinfo::CHARINFO_VERSION_POSITION
+				&& SameZoneIdentity(s_current.zone(), s_lastPublished.zone()))
+				dirty &= ~zone;
+		}
+	}
+
+	if (s_initialized && !s_justZoned && s_compatPublishPending)
+		SendFullPublish(&s_current);
+
+	if (s_initialized && s_justZoned && charinfo::MinPeerVersion() >= charinfo::CHARINFO_VERSION_SNAPSHOT_HANDSHAKE) {
+		// Peers still hold our snapshot from before the zone: send what changed, with a checkpoint
+		// so anyone who lost it asks for a resync.
+		SendUpdate(dirty, true);
+		SendJoined(s_current.sender());
+		s_justZoned = false;
+	} else if (!s_initialized || s_justZoned) {
+		SendFullPublish(&s_current);
+		SendJoined(s_current.sender());
+		s_lastPublished = s_current;
+		s_lastPublishedChecksum = charinfo::StateChecksum(s_lastPublished);
+		s_sharedDirtySections = charinfo::kAllSections;
 		s_initialized = true;
 		s_justZoned = false;
-	} else {
-		mq::proto::charinfo::CharinfoUpdate update;
-		update.set_sender(payload.sender());
-		if (charinfo::BuildUpdatePayload(payload, s_lastPublished, &update) && update.updates_size() > 0) {
-			SendUpdate(update);
-			s_lastPublished = payload;
+	} else if (dirty != 0 || checkpoint) {
+		if ((dirty & zone) && SameZoneIdentity(s_current.zone(), s_lastPublished.zone())) {
+			SendPositionUpdate();
+			dirty &= ~zone;
 		}
+		if (dirty != 0 || checkpoint)
+			SendUpdate(dirty, checkpoint);
 	}
 }
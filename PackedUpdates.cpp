@@ -0,0 +1,242 @@
+/*
+ * MQCharinfo - Packed scalar framing for CharinfoUpdate.packed (1.9+).
+ */
+
+#include "PackedUpdates.h"
+
+#include <cmath>
+
+namespace charinfo {
+
+namespace {
+
+enum class PackedKind : uint8_t { None, I32, I64, Fixed2, Bits, Bool, Str };
+
+static_assert(mq::proto::charinfo::CharinfoFieldId_MAX < 64, "packed field mask is 64 bits");
+
+// Wire kind of every scalar CharinfoFieldId (matching the ADD_SCALAR_* used for it in
+// BuildUpdatePayload); None = submessage or list, which stays a FieldUpdate.
+static PackedKind PackedKindOf(int fieldId)
+{
+	using Id = mq::proto::charinfo::CharinfoFieldId;
+	switch (fieldId) {
+	case Id::FIELD_sender:
+	case Id::FIELD_name:
+		return PackedKind::Str;
+	case Id::FIELD_id:
+	case Id::FIELD_level:
+	case Id::FIELD_pct_hps:
+	case Id::FIELD_pct_mana:
+	case Id::FIELD_target_hp:
+	case Id::FIELD_free_buff_slots:
+	case Id::FIELD_detrimentals:
+	case Id::FIELD_count_poison:
+	case Id::FIELD_count_disease:
+	case Id::FIELD_count_curse:
+	case Id::FIELD_count_corruption:
+	case Id::FIELD_pet_hp:
+	case Id::FIELD_max_endurance:
+	case Id::FIELD_current_mana:
+	case Id::FIELD_max_mana:
+	case Id::FIELD_current_endurance:
+	case Id::FIELD_pct_endurance:
+	case Id::FIELD_pet_id:
+	case Id::FIELD_casting_spell_id:
+	case Id::FIELD_combat_state:
+		return PackedKind::I32;
+	case Id::FIELD_current_hp:
+	case Id::FIELD_max_hp:
+	case Id::FIELD_no_cure:
+	case Id::FIELD_life_drain:
+	case Id::FIELD_mana_drain:
+	case Id::FIELD_endu_drain:
+		return PackedKind::I64;
+	case Id::FIELD_state_bits:
+	case Id::FIELD_detr_state_bits:
+	case Id::FIELD_bene_state_bits:
+		return PackedKind::Bits;
+	case Id::FIELD_pet_affinity:
+		return PackedKind::Bool;
+	case Id::FIELD_version:
+		return PackedKind::Fixed2;
+	default:
+		return PackedKind::None;
+	}
+}
+
+static bool PackableAs(const mq::proto::charinfo::FieldUpdate& update, PackedKind kind)
+{
+	using Value = mq::proto::charinfo::FieldUpdate::ValueCase;
+	switch (kind) {
+	case PackedKind::I32: return update.value_case() == Value::kI32;
+	case PackedKind::I64: return update.value_case() == Value::kI64;
+	case PackedKind::Fixed2: return update.value_case() == Value::kF;
+	case PackedKind::Bits: return update.value_case() == Value::kBits;
+	case PackedKind::Bool: return update.value_case() == Value::kB;
+	case PackedKind::Str: return update.value_case() == Value::kStr;
+	default: return false;
+	}
+}
+
+static void PutVarint(std::string* out, uint64_t value)
+{
+	while (value >= 0x80) {
+		out->push_back(static_cast<char>(value | 0x80));
+		value >>= 7;
+	}
+	out->push_back(static_cast<char>(value));
+}
+
+static uint64_t ZigZag(int64_t value)
+{
+	return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+static int64_t UnZigZag(uint64_t value)
+{
+	return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+static int64_t ToFixed2(float value)
+{
+	return std::isfinite(value) ? static_cast<int64_t>(std::llround(static_cast<double>(value) * 100.0)) : 0;
+}
+
+} // namespace
+
+int PackScalarUpdates(mq::proto::charinfo::CharinfoUpdate* update)
+{
+	auto* updates = update->mutable_updates();
+	const mq::proto::charinfo::FieldUpdate* byId[64] = {};
+	uint64_t mask = 0;
+	for (const auto& u : *updates) {
+		const int fieldId = static_cast<int>(u.field_id());
+		// The packed form holds one value per field: the first occurrence is packed and any
+		// later one with the same id is dropped below.
+		if (fieldId > 0 && fieldId < 64 && !byId[fieldId] && PackableAs(u, PackedKindOf(fieldId))) {
+			byId[fieldId] = &u;
+			mask |= uint64_t(1) << fieldId;
+		}
+	}
+	if (mask == 0)
+		return 0;
+
+	std::string* out = update->mutable_packed();
+	out->clear();
+	PutVarint(out, mask);
+	int packed = 0;
+	for (int fieldId = 1; fieldId < 64; fieldId++) {
+		const mq::proto::charinfo::FieldUpdate* u = byId[fieldId];
+		if (!u)
+			continue;
+		packed++;
+		switch (PackedKindOf(fieldId)) {
+		case PackedKind::I32: PutVarint(out, ZigZag(u->i32())); break;
+		case PackedKind::I64: PutVarint(out, ZigZag(u->i64())); break;
+		case PackedKind::Fixed2: PutVarint(out, ZigZag(ToFixed2(u->f()))); break;
+		case PackedKind::Bits:
+			for (int shift = 0; shift < 32; shift += 8)
+				out->push_back(static_cast<char>((u->bits() >> shift) & 0xff));
+			break;
+		case PackedKind::Bool: out->push_back(u->b() ? 1 : 0); break;
+		case PackedKind::Str: PutVarint(out, u->str().size()); out->append(u->str()); break;
+		default: break;
+		}
+	}
+
+	// Drop the packed entries and their duplicates, keeping the rest in order.
+	int kept = 0;
+	for (int i = 0; i < updates->size(); i++) {
+		const int fieldId = static_cast<int>(updates->Get(i).field_id());
+		const bool wasPacked = fieldId > 0 && fieldId < 64 && (mask & (uint64_t(1) << fieldId));
+		if (!wasPacked) {
+			if (kept != i)
+				updates->SwapElements(kept, i);
+			kept++;
+		}
+	}
+	while (updates->size() > kept)
+		updates->RemoveLast();
+	return packed;
+}
+
+PackedUpdateReader::PackedUpdateReader(const std::string& packed)
+	: m_pos(reinterpret_cast<const uint8_t*>(packed.data())), m_end(m_pos + packed.size())
+{
+	m_failed = !Varint(&m_mask);
+}
+
+bool PackedUpdateReader::Next(mq::proto::charinfo::FieldUpdate* update)
+{
+	if (m_failed)
+		return false;
+	while (m_mask != 0 && !(m_mask & 1)) {
+		m_mask >>= 1;
+		m_fieldId++;
+	}
+	if (m_mask == 0)
+		return false;
+	const int fieldId = m_fieldId;
+	m_mask >>= 1;
+	m_fieldId++;
+
+	update->set_field_id(static_cast<mq::proto::charinfo::CharinfoFieldId>(fieldId));
+	uint64_t raw = 0;
+	const uint8_t* bytes = nullptr;
+	switch (PackedKindOf(fieldId)) {
+	case PackedKind::I32:
+		if (!Varint(&raw)) break;
+		update->set_i32(static_cast<int32_t>(UnZigZag(raw)));
+		return true;
+	case PackedKind::I64:
+		if (!Varint(&raw)) break;
+		update->set_i64(UnZigZag(raw));
+		return true;
+	case PackedKind::Fixed2:
+		if (!Varint(&raw)) break;
+		update->set_f(static_cast<float>(UnZigZag(raw)) / 100.0f);
+		return true;
+	case PackedKind::Bits:
+		if (!Bytes(4, &bytes)) break;
+		update->set_bits(static_cast<uint32_t>(bytes[0]) | static_cast<uint32_t>(bytes[1]) << 8
+			| static_cast<uint32_t>(bytes[2]) << 16 | static_cast<uint32_t>(bytes[3]) << 24);
+		return true;
+	case PackedKind::Bool:
+		if (!Bytes(1, &bytes)) break;
+		update->set_b(bytes[0] != 0);
+		return true;
+	case PackedKind::Str:
+		if (!Varint(&raw) || !Bytes(static_cast<size_t>(raw), &bytes)) break;
+		update->set_str(reinterpret_cast<const char*>(bytes), static_cast<size_t>(raw));
+		return true;
+	default:
+		break;
+	}
+	m_failed = true;
+	return false;
+}
+
+bool PackedUpdateReader::Varint(uint64_t* value)
+{
+	uint64_t result = 0;
+	for (int shift = 0; shift < 64 && m_pos < m_end; shift += 7) {
+		const uint8_t byte = *m_pos++;
+		result |= static_cast<uint64_t>(byte & 0x7f) << shift;
+		if (!(byte & 0x80)) {
+			*value = result;
+			return true;
+		}
+	}
+	return false;
+}
+
+bool PackedUpdateReader::Bytes(size_t count, const uint8_t** bytes)
+{
+	if (static_cast<size_t>(m_end - m_pos) < count)
+		return false;
+	*bytes = m_pos;
+	m_pos += count;
+	return true;
+}
+
+} // namespace charinfo
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "charinfo.pb.h"
+
+#include <cstdint>
+#include <string>
+
+namespace charinfo {
+
+// Move the scalar FieldUpdates of an update into its packed bytes (see CharinfoUpdate.packed).
+// A field id that appears more than once is packed from its first occurrence; the rest are
+// dropped. Returns the number of fields packed.
+int PackScalarUpdates(mq::proto::charinfo::CharinfoUpdate* update);
+
+// Decodes CharinfoUpdate.packed one field at a time, in field-id order.
+class PackedUpdateReader {
+public:
+	explicit PackedUpdateReader(const std::string& packed);
+
+	// Fills `update` with the next field (id and value). Returns false at the end of the
+	// fields or on malformed input; Failed() tells which.
+	bool Next(mq::proto::charinfo::FieldUpdate* update);
+	bool Failed() const { return m_failed; }
+
+private:
+	bool Varint(uint64_t* value);
+	bool Bytes(size_t count, const uint8_t** bytes);
+
+	const uint8_t* m_pos;
+	const uint8_t* m_end;
+	uint64_t m_mask = 0;
+	int m_fieldId = 0;
+	bool m_failed = false;
+};
+
+} // namespace charinfo
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "charinfo.pb.h"
+
+#include <cmath>
+
+namespace charinfo {
+
+// Submessage equality for BuildUpdatePayload, field by field: no serialization and no allocation.
+// Free of game dependencies so the benchmark in bench/ runs the same code.
+
+inline bool SpellInfoEqual(const mq::proto::charinfo::SpellInfo& a, const mq::proto::charinfo::SpellInfo& b) {
+	return a.id() == b.id() && a.name() == b.name() && a.category() == b.category() && a.level() == b.level();
+}
+
+inline bool FloatEqual(float a, float b) {
+	return a == b || (std::isnan(a) && std::isnan(b));
+}
+
+inline bool ClassInfoEqual(const mq::proto::charinfo::ClassInfo& a, const mq::proto::charinfo::ClassInfo& b) {
+	return a.id() == b.id() && a.name() == b.name() && a.short_name() == b.short_name();
+}
+
+inline bool TargetInfoEqual(const mq::proto::charinfo::TargetInfo& a, const mq::proto::charinfo::TargetInfo& b) {
+	return a.id() == b.id() && a.name() == b.name();
+}
+
+inline bool ZoneInfoEqual(const mq::proto::charinfo::ZoneInfo& a, const mq::proto::charinfo::ZoneInfo& b) {
+	return a.id() == b.id() && a.instance_id() == b.instance_id()
+		&& FloatEqual(a.x(), b.x()) && FloatEqual(a.y(), b.y()) && FloatEqual(a.z(), b.z()) && FloatEqual(a.heading(), b.heading())
+		&& a.short_name() == b.short_name() && a.name() == b.name();
+}
+
+// Zone identity only: for 2.5+ receivers, movement travels as PositionInfo fixes.
+inline bool ZoneIdentityEqual(const mq::proto::charinfo::ZoneInfo& a, const mq::proto::charinfo::ZoneInfo& b) {
+	return a.id() == b.id() && a.instance_id() == b.instance_id()
+		&& a.short_name() == b.short_name() && a.name() == b.name();
+}
+
+inline bool PositionInfoEqual(const mq::proto::charinfo::PositionInfo& a, const mq::proto::charinfo::PositionInfo& b) {
+	return a.at_ms() == b.at_ms() && a.x() == b.x() && a.y() == b.y() && a.z() == b.z()
+		&& a.vx() == b.vx() && a.vy() == b.vy() && a.vz() == b.vz() && a.heading() == b.heading();
+}
+
+inline bool ExperienceInfoEqual(const mq::proto::charinfo::ExperienceInfo& a, const mq::proto::charinfo::ExperienceInfo& b) {
+	return FloatEqual(a.pct_exp(), b.pct_exp()) && FloatEqual(a.pct_aa_exp(), b.pct_aa_exp())
+		&& FloatEqual(a.pct_group_leader_exp(), b.pct_group_leader_exp())
+		&& a.total_aa() == b.total_aa() && a.aa_spent() == b.aa_spent()
+		&& a.aa_unused() == b.aa_unused() && a.aa_assigned() == b.aa_assigned();
+}
+
+inline bool MakeCampInfoEqual(const mq::proto::charinfo::MakeCampInfo& a, const mq::proto::charinfo::MakeCampInfo& b) {
+	return a.status() == b.status() && FloatEqual(a.x(), b.x()) && FloatEqual(a.y(), b.y())
+		&& FloatEqual(a.radius(), b.radius()) && FloatEqual(a.distance(), b.distance());
+}
+
+inline bool MacroInfoEqual(const mq::proto::charinfo::MacroInfo& a, const mq::proto::charinfo::MacroInfo& b) {
+	return a.macro_state() == b.macro_state() && a.macro_name() == b.macro_name();
+}
+
+inline bool LuaScriptInfoEqual(const mq::proto::charinfo::LuaScriptInfo& a, const mq::proto::charinfo::LuaScriptInfo& b) {
+	if (a.pid() != b.pid() || a.status() != b.status() || a.name() != b.name() || a.path() != b.path()
+		|| a.arguments_size() != b.arguments_size())
+		return false;
+	for (int i = 0; i < a.arguments_size(); i++)
+		if (a.arguments(i) != b.arguments(i)) return false;
+	return true;
+}
+
+inline bool LuaInfoEqual(const mq::proto::charinfo::LuaInfo& a, const mq::proto::charinfo::LuaInfo& b) {
+	if (a.scripts_size() != b.scripts_size()) return false;
+	for (int i = 0; i < a.scripts_size(); i++)
+		if (!LuaScriptInfoEqual(a.scripts(i), b.scripts(i))) return false;
+	return true;
+}
+
+} // namespace charinfo
@@ -0,0 +1,70 @@
+/*
+ * MQCharinfo - Per-section publish cadence (idle vs combat), configurable per character.
+ */
+
+#include "PublishScheduler.h"
+#include "mq/Plugin.h"
+
+#include <algorithm>
+
+namespace charinfo {
+
+using std::chrono::milliseconds;
+
+// Defaults, idle / active (ms). Vitals and target follow combat closely; bulk sections stay slow.
+static const SectionCadence kDefaultCadence[] = {
+	{ milliseconds(5000), milliseconds(5000) },   // Identity
+	{ milliseconds(1000), milliseconds(200) },    // Vitals
+	{ milliseconds(1000), milliseconds(250) },    // Target
+	{ milliseconds(1000), milliseconds(250) },    // Zone (active while moving)
+	{ milliseconds(1000), milliseconds(500) },    // Buffs
+	{ milliseconds(3000), milliseconds(3000) },   // BuffTimers
+	{ milliseconds(1000), milliseconds(500) },    // Pet
+	{ milliseconds(5000), milliseconds(2000) },   // Gems
+	{ milliseconds(10000), milliseconds(10000) }, // Experience
+	{ milliseconds(2000), milliseconds(1000) },   // MakeCamp
+	{ milliseconds(2000), milliseconds(2000) },   // Macro
+	{ milliseconds(10000), milliseconds(10000) }, // Lua
+	{ milliseconds(10000), milliseconds(10000) }, // Inventory
+};
+static_assert(sizeof(kDefaultCadence) / sizeof(kDefaultCadence[0]) == static_cast<size_t>(PublishSection::Count),
+	"kDefaultCadence must have one entry per PublishSection");
+
+// Lower bound for INI overrides; OnPulse runs every frame, anything faster is just noise.
+static constexpr int kMinCadenceMs = 50;
+
+PublishScheduler::PublishScheduler()
+{
+	for (size_t i = 0; i < static_cast<size_t>(PublishSection::Count); i++)
+		m_cadence[i] = kDefaultCadence[i];
+}
+
+void PublishScheduler::LoadSettings(const std::string& iniSection)
+{
+	for (size_t i = 0; i < static_cast<size_t>(PublishSection::Count); i++) {
+		const std::string key = SectionName(static_cast<PublishSection>(i));
+		const int idle = GetPrivateProfileInt(iniSection.c_str(), key.c_str(), static_cast<int>(kDefaultCadence[i].idle.count()), INIFileName);
+		const int active = GetPrivateProfileInt(iniSection.c_str(), (key + "Combat").c_str(), static_cast<int>(kDefaultCadence[i].active.count()), INIFileName);
+		m_cadence[i].idle = milliseconds(std::max(idle, kMinCadenceMs));
+		m_cadence[i].active = milliseconds(std::max(active, kMinCadenceMs));
+	}
+	m_forced = kAllSections;
+}
+
+SectionMask PublishScheduler::Due(std::chrono::steady_clock::time_point now, bool inCombat, bool moving)
+{
+	SectionMask due = m_forced;
+	m_forced = 0;
+	for (size_t i = 0; i < static_cast<size_t>(PublishSection::Count); i++) {
+		const SectionMask bit = SectionBit(static_cast<PublishSection>(i));
+		const bool active = inCombat || (moving && static_cast<PublishSection>(i) == PublishSection::Zone);
+		const milliseconds cadence = active ? m_cadence[i].active : m_cadence[i].idle;
+		if ((due & bit) || now - m_lastSampled[i] >= cadence) {
+			due |= bit;
+			m_lastSampled[i] = now;
+		}
+	}
+	return due;
+}
+
+} // namespace charinfo
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "Charinfo.h"
+
+#include <chrono>
+#include <string>
+
+namespace charinfo {
+
+// Sample cadence for one PublishSection: idle, and "active" while in combat (Zone: also while moving).
+struct SectionCadence {
+	std::chrono::milliseconds idle;
+	std::chrono::milliseconds active;
+};
+
+// Decides which PublishSections are due for sampling. Each section keeps its own cadence and switches to
+// its active cadence as soon as combat starts; per-character overrides are read from the plugin INI.
+class PublishScheduler {
+public:
+	PublishScheduler();
+
+	// Read overrides from [iniSection], e.g. Vitals=1000 / VitalsCombat=150 (milliseconds).
+	void LoadSettings(const std::string& iniSection);
+
+	// Sections due at now. Returned sections are considered sampled at now.
+	SectionMask Due(std::chrono::steady_clock::time_point now, bool inCombat, bool moving);
+
+	// Make every section due on the next call to Due (first publish, zoning).
+	void ForceAll() { m_forced = kAllSections; }
+
+	const SectionCadence& Cadence(PublishSection section) const { return m_cadence[static_cast<size_t>(section)]; }
+
+private:
+	SectionCadence m_cadence[static_cast<size_t>(PublishSection::Count)];
+	std::chrono::steady_clock::time_point m_lastSampled[static_cast<size_t>(PublishSection::Count)];
+	SectionMask m_forced = kAllSections;
+};
+
+} // namespace charinfo
@@ -0,0 +1,324 @@
+/*
+ * MQCharinfo - Shared-memory snapshots for characters running on the same machine.
+ */
+
+#include "SharedSnapshots.h"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+namespace charinfo {
+
+namespace {
+
+// "MQC" and the layout revision: a region from a build with another layout is left alone.
+constexpr uint32_t kMagic = 0x4D514302;
+constexpr size_t kNameBytes = 64;
+// Room for a full publish with every buff, gem and Lua script; larger snapshots go by postoffice.
+constexpr size_t kSlotBytes = 16 * 1024;
+// A slot whose heartbeat is older than this belongs to a client that went away without releasing it.
+constexpr int64_t kStaleMs = 5000;
+// Seqlock read retries before a slot is left for the next pass.
+constexpr int kReadAttempts = 4;
+
+uint32_t ProcessId()
+{
+#ifdef _WIN32
+	return static_cast<uint32_t>(GetCurrentProcessId());
+#else
+	return static_cast<uint32_t>(getpid());
+#endif
+}
+
+} // namespace
+
+// Zero-filled on creation, which is the initial state of every field.
+struct SharedSnapshots::Region {
+	struct Slot {
+		std::atomic<uint32_t> version;      // seqlock: odd while name/size/data are being written
+		std::atomic<uint32_t> owner;        // process ID holding the slot; 0 = free
+		std::atomic<int64_t> heartbeat_ms;  // ClockMs of the owner's last write or touch
+		uint32_t data_version;              // version after the last write of name/size/data
+		uint32_t size;
+		char name[kNameBytes];
+		SharedVitals vitals;
+		unsigned char data[kSlotBytes];
+	};
+
+	std::atomic<uint32_t> magic;
+	std::atomic<uint32_t> changes;          // bumped after every write or release
+	Slot slots[kSlotCount];
+};
+
+SharedSnapshots::~SharedSnapshots()
+{
+	Close();
+}
+
+bool SharedSnapshots::Open(const std::string& name)
+{
+	Close();
+#ifdef _WIN32
+	HANDLE mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, 0,
+		static_cast<DWORD>(sizeof(Region)), ("Local\\" + name).c_str());
+	if (!mapping)
+		return false;
+	void* view = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, sizeof(Region));
+	if (!view) {
+		CloseHandle(mapping);
+		return false;
+	}
+	m_handle = mapping;
+#else
+	const int fd = shm_open(("/" + name).c_str(), O_CREAT | O_RDWR, 0600);
+	if (fd < 0)
+		return false;
+	struct stat st = {};
+	if (fstat(fd, &st) != 0 || (static_cast<size_t>(st.st_size) < sizeof(Region) && ftruncate(fd, sizeof(Region)) != 0)) {
+		close(fd);
+		return false;
+	}
+	void* view = mmap(nullptr, sizeof(Region), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	if (view == MAP_FAILED)
+		return false;
+#endif
+	m_region = static_cast<Region*>(view);
+
+	uint32_t magic = 0;
+	if (!m_region->magic.compare_exchange_strong(magic, kMagic) && magic != kMagic) {
+		Close();
+		return false;
+	}
+	m_slot = -1;
+	m_seenChanges = m_region->changes.load(std::memory_order_acquire) - 1;
+	std::fill(std::begin(m_seenVersions), std::end(m_seenVersions), 0u);
+	std::fill(std::begin(m_seenDataVersions), std::end(m_seenDataVersions), 0u);
+	return true;
+}
+
+void SharedSnapshots::Close()
+{
+	if (!m_region)
+		return;
+	Release();
+#ifdef _WIN32
+	UnmapViewOfFile(m_region);
+	CloseHandle(static_cast<HANDLE>(m_handle));
+#else
+	munmap(m_region, sizeof(Region));
+#endif
+	m_region = nullptr;
+	m_handle = nullptr;
+}
+
+// Take our slot from a previous login of this client, else a free one, else an abandoned one.
+bool SharedSnapshots::Claim(int64_t nowMs)
+{
+	const uint32_t pid = ProcessId();
+	int claimed = -1;
+	for (int i = 0; i < kSlotCount && claimed < 0; ++i) {
+		if (m_region->slots[i].owner.load(std::memory_order_acquire) == pid)
+			claimed = i;
+	}
+	for (int i = 0; i < kSlotCount && claimed < 0; ++i) {
+		uint32_t owner = 0;
+		if (m_region->slots[i].owner.compare_exchange_strong(owner, pid))
+			claimed = i;
+	}
+	for (int i = 0; i < kSlotCount && claimed < 0; ++i) {
+		Region::Slot& slot = m_region->slots[i];
+		uint32_t owner = slot.owner.load(std::memory_order_acquire);
+		if (nowMs - slot.heartbeat_ms.load(std::memory_order_relaxed) > kStaleMs
+			&& slot.owner.compare_exchange_strong(owner, pid)) {
+			// The old owner's snapshot must not be read as ours until our first write.
+			ClearSlot(i);
+			claimed = i;
+		}
+	}
+	if (claimed < 0)
+		return false;
+	m_slot = claimed;
+	m_region->slots[claimed].heartbeat_ms.store(nowMs, std::memory_order_relaxed);
+	return true;
+}
+
+bool SharedSnapshots::Write(const std::string& character, const std::string& bytes, const SharedVitals& vitals, int64_t nowMs)
+{
+	if (!m_region)
+		return false;
+	if (character.empty() || character.size() >= kNameBytes || bytes.size() > kSlotBytes) {
+		Release();
+		return false;
+	}
+	if (m_slot < 0 && !Claim(nowMs))
+		return false;
+
+	Region::Slot& slot = m_region->slots[m_slot];
+	const uint32_t version = slot.version.load(std::memory_order_relaxed);
+	slot.version.store(version + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	std::memcpy(slot.name, character.c_str(), character.size() + 1);
+	slot.size = static_cast<uint32_t>(bytes.size());
+	std::memcpy(slot.data, bytes.data(), bytes.size());
+	slot.vitals = vitals;
+	slot.data_version = version + 2;
+	slot.version.store(version + 2, std::memory_order_release);
+	slot.heartbeat_ms.store(nowMs, std::memory_order_relaxed);
+	m_region->changes.fetch_add(1, std::memory_order_release);
+	return true;
+}
+
+bool SharedSnapshots::WriteVitals(const SharedVitals& vitals, int64_t nowMs)
+{
+	if (!m_region || m_slot < 0)
+		return false;
+
+	Region::Slot& slot = m_region->slots[m_slot];
+	const uint32_t version = slot.version.load(std::memory_order_relaxed);
+	slot.version.store(version + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	slot.vitals = vitals;
+	slot.version.store(version + 2, std::memory_order_release);
+	slot.heartbeat_ms.store(nowMs, std::memory_order_relaxed);
+	m_region->changes.fetch_add(1, std::memory_order_release);
+	return true;
+}
+
+void SharedSnapshots::Touch(int64_t nowMs)
+{
+	if (m_region && m_slot >= 0)
+		m_region->slots[m_slot].heartbeat_ms.store(nowMs, std::memory_order_relaxed);
+}
+
+void SharedSnapshots::ClearSlot(int index)
+{
+	Region::Slot& slot = m_region->slots[index];
+	const uint32_t version = slot.version.load(std::memory_order_relaxed);
+	slot.version.store(version + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	slot.name[0] = '\0';
+	slot.size = 0;
+	slot.vitals = SharedVitals();
+	slot.data_version = version + 2;
+	slot.version.store(version + 2, std::memory_order_release);
+	m_region->changes.fetch_add(1, std::memory_order_release);
+}
+
+void SharedSnapshots::Release()
+{
+	if (!m_region || m_slot < 0)
+		return;
+	ClearSlot(m_slot);
+	Region::Slot& slot = m_region->slots[m_slot];
+	slot.heartbeat_ms.store(0, std::memory_order_relaxed);
+	slot.owner.store(0, std::memory_order_release);
+	m_slot = -1;
+}
+
+SharedSnapshots::SlotRead SharedSnapshots::ReadSlot(int index, bool withData, bool* copiedData)
+{
+	const Region::Slot& slot = m_region->slots[index];
+	for (int attempt = 0; attempt < kReadAttempts; ++attempt) {
+		const uint32_t version = slot.version.load(std::memory_order_acquire);
+		if (version & 1)
+			continue;
+		if (version == m_seenVersions[index] && !withData)
+			return SlotRead::Unchanged;
+		const uint32_t dataVersion = slot.data_version;
+		const bool data = withData || dataVersion != m_seenDataVersions[index];
+		if (data)
+			m_readBuffer.assign(reinterpret_cast<const char*>(slot.data), std::min<size_t>(slot.size, kSlotBytes));
+		m_readName.assign(slot.name, strnlen(slot.name, kNameBytes));
+		std::memcpy(&m_readVitals, &slot.vitals, sizeof(SharedVitals));
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (slot.version.load(std::memory_order_relaxed) != version)
+			continue;
+		m_readVitals.target_name[SharedVitals::kTargetNameBytes - 1] = '\0';
+		m_seenVersions[index] = version;
+		if (data)
+			m_seenDataVersions[index] = dataVersion;
+		*copiedData = data;
+		return SlotRead::Read;
+	}
+	return SlotRead::Busy;
+}
+
+void SharedSnapshots::ReadChanged(const std::string& self, int64_t nowMs, const Visitor& visit)
+{
+	if (!m_region)
+		return;
+	const uint32_t changes = m_region->changes.load(std::memory_order_acquire);
+	if (changes == m_seenChanges)
+		return;
+	m_seenChanges = changes;
+
+	for (int i = 0; i < kSlotCount; ++i) {
+		if (i == m_slot)
+			continue;
+		const Region::Slot& slot = m_region->slots[i];
+		if (slot.owner.load(std::memory_order_acquire) == 0
+			|| nowMs - slot.heartbeat_ms.load(std::memory_order_relaxed) > kStaleMs)
+			continue;
+
+		bool copiedData = false;
+		SlotRead read = ReadSlot(i, false, &copiedData);
+		if (read == SlotRead::Read && !m_readName.empty() && m_readName != self
+			&& !visit(m_readName, copiedData ? &m_readBuffer : nullptr, m_readVitals) && !copiedData) {
+			// Vitals the visitor has no snapshot for: read the slot again, snapshot included.
+			read = ReadSlot(i, true, &copiedData);
+			if (read == SlotRead::Read && !m_readName.empty() && m_readName != self)
+				visit(m_readName, &m_readBuffer, m_readVitals);
+		}
+		if (read == SlotRead::Busy) {
+			// Still being written: look again on the next call even if nothing else changes.
+			m_seenVersions[i] = 0;
+			m_seenChanges = changes - 1;
+		}
+	}
+}
+
+bool SharedSnapshots::IsLive(const std::string& character, int64_t nowMs) const
+{
+	if (!m_region || character.empty() || character.size() >= kNameBytes)
+		return false;
+	for (int i = 0; i < kSlotCount; ++i) {
+		const Region::Slot& slot = m_region->slots[i];
+		if (slot.owner.load(std::memory_order_acquire) == 0
+			|| nowMs - slot.heartbeat_ms.load(std::memory_order_relaxed) > kStaleMs)
+			continue;
+		// The name is rewritten by every Write: read it under the seqlock, as ReadChanged does.
+		for (int attempt = 0; attempt < kReadAttempts; ++attempt) {
+			const uint32_t version = slot.version.load(std::memory_order_acquire);
+			if (version & 1)
+				continue;
+			char name[kNameBytes];
+			std::memcpy(name, slot.name, kNameBytes);
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if (slot.version.load(std::memory_order_relaxed) != version)
+				continue;
+			if (std::strncmp(name, character.c_str(), kNameBytes) == 0)
+				return true;
+			break;
+		}
+	}
+	return false;
+}
+
+} // namespace charinfo
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace charinfo {
+
+// Vitals, target and casting state kept in a fixed layout beside each slot's snapshot, so a change
+// to only these is written and read without serializing or parsing the snapshot.
+struct SharedVitals {
+	static constexpr size_t kTargetNameBytes = 64;
+
+	uint32_t seq = 0;
+	int64_t clock_ms = 0;
+	int64_t current_hp = 0, max_hp = 0;
+	int32_t pct_hps = 0;
+	int32_t current_mana = 0, max_mana = 0, pct_mana = 0;
+	int32_t current_endurance = 0, max_endurance = 0, pct_endurance = 0;
+	int64_t no_cure = 0, life_drain = 0, mana_drain = 0, endu_drain = 0;
+	uint32_t state_bits = 0, detr_state_bits = 0, bene_state_bits = 0;
+	int32_t casting_spell_id = 0;
+	int32_t combat_state = 0;
+	int32_t target_id = 0;
+	int32_t target_hp = 0;
+	char target_name[kTargetNameBytes] = {};
+};
+
+// Latest serialized CharinfoPublish of every character on this machine, in a named shared-memory
+// region: one seqlock-protected slot per character plus a change counter bumped on every write.
+// Slots not refreshed for a few seconds (crashed client) are treated as free.
+class SharedSnapshots {
+public:
+	static constexpr int kSlotCount = 64;
+
+	SharedSnapshots() = default;
+	SharedSnapshots(const SharedSnapshots&) = delete;
+	SharedSnapshots& operator=(const SharedSnapshots&) = delete;
+	~SharedSnapshots();
+
+	// Map (creating it if needed) the region called `name`. Returns false if shared memory is
+	// unavailable or the region was created by an incompatible build.
+	bool Open(const std::string& name);
+	void Close();
+	bool IsOpen() const { return m_region != nullptr; }
+
+	// True while our snapshot is in a slot: the last Write succeeded and nothing released it since.
+	bool HoldsSlot() const { return m_region != nullptr && m_slot >= 0; }
+
+	// Store our snapshot and its vitals under `character`, claiming a slot on first use. Returns false
+	// when no slot is free or the snapshot does not fit; our slot is then released so readers use
+	// postoffice.
+	bool Write(const std::string& character, const std::string& bytes, const SharedVitals& vitals, int64_t nowMs);
+
+	// Replace only the vitals of the snapshot in our slot. Returns false without a slot (Write first).
+	bool WriteVitals(const SharedVitals& vitals, int64_t nowMs);
+
+	// Keep our slot alive without rewriting it.
+	void Touch(int64_t nowMs);
+
+	// Give up our slot (logout, unload).
+	void Release();
+
+	// Visit the live slots of other characters written since they were last visited. `bytes` is the
+	// snapshot when it was rewritten since, else null: only the vitals changed. A visitor that can't
+	// use the vitals alone (no snapshot of that character yet) returns false and is called again
+	// with the snapshot. Both are only valid during the call.
+	using Visitor = std::function<bool(const std::string& character, const std::string* bytes, const SharedVitals& vitals)>;
+	void ReadChanged(const std::string& self, int64_t nowMs, const Visitor& visit);
+
+	// True if `character` has a slot refreshed recently.
+	bool IsLive(const std::string& character, int64_t nowMs) const;
+
+private:
+	struct Region;
+
+	enum class SlotRead { Read, Unchanged, Busy };
+
+	bool Claim(int64_t nowMs);
+	// Copy a slot's name and vitals, and its snapshot when `withData` or rewritten since we last
+	// copied it, under the seqlock.
+	SlotRead ReadSlot(int slot, bool withData, bool* copiedData);
+	// Empty a slot's name and data under its seqlock so readers drop what it held.
+	void ClearSlot(int slot);
+
+	Region* m_region = nullptr;
+	void* m_handle = nullptr;
+	int m_slot = -1;
+	uint32_t m_seenChanges = 0;
+	uint32_t m_seenVersions[kSlotCount] = {};
+	uint32_t m_seenDataVersions[kSlotCount] = {};
+	std::string m_readBuffer;
+	std::string m_readName;
+	SharedVitals m_readVitals;
+};
+
+} // namespace charinfo
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "SharedSnapshots.h"
+#include "charinfo.pb.h"
+
+#include <cstring>
+
+namespace charinfo {
+
+// The Vitals and Target sections of a snapshot in the fixed layout of a shared-memory slot.
+// Free of game dependencies so the benchmark in bench/ runs the same code.
+
+// Fill `out` from `pub`. Returns false if the target name doesn't fit; the snapshot then has to be
+// written whole.
+inline bool ToSharedVitals(const mq::proto::charinfo::CharinfoPublish& pub, SharedVitals* out) {
+	const std::string& targetName = pub.target().name();
+	if (targetName.size() >= SharedVitals::kTargetNameBytes)
+		return false;
+	out->seq = pub.seq();
+	out->clock_ms = pub.clock_ms();
+	out->current_hp = pub.current_hp();
+	out->max_hp = pub.max_hp();
+	out->pct_hps = pub.pct_hps();
+	out->current_mana = pub.current_mana();
+	out->max_mana = pub.max_mana();
+	out->pct_mana = pub.pct_mana();
+	out->current_endurance = pub.current_endurance();
+	out->max_endurance = pub.max_endurance();
+	out->pct_endurance = pub.pct_endurance();
+	out->no_cure = pub.no_cure();
+	out->life_drain = pub.life_drain();
+	out->mana_drain = pub.mana_drain();
+	out->endu_drain = pub.endu_drain();
+	out->state_bits = pub.state_bits();
+	out->detr_state_bits = pub.detr_state_bits();
+	out->bene_state_bits = pub.bene_state_bits();
+	out->casting_spell_id = pub.casting_spell_id();
+	out->combat_state = pub.combat_state();
+	out->target_id = pub.target().id();
+	out->target_hp = pub.target_hp();
+	std::memcpy(out->target_name, targetName.c_str(), targetName.size() + 1);
+	return true;
+}
+
+} // namespace charinfo
@@ -0,0 +1,75 @@
+/*
+ * MQCharinfo - Process-wide spell metadata cache shared by payload build and peer resolution.
+ */
+
+#include "SpellCache.h"
+#include "mq/Plugin.h"
+
+#include <eqlib/game/Spells.h>
+
+#include <unordered_map>
+
+namespace charinfo {
+
+namespace {
+
+// Entries for unknown IDs are cached too (valid = false) so bad IDs don't hit the spell manager again.
+struct CacheEntry {
+	bool valid = false;
+	SpellMeta meta;
+};
+
+std::unordered_map<int, CacheEntry> s_spellCache;
+const void* s_spellManager = nullptr;
+SpellCacheStats s_stats;
+
+} // namespace
+
+void InvalidateSpellCache()
+{
+	s_spellCache.clear();
+	s_stats.entries = 0;
+	s_stats.invalidations++;
+}
+
+const SpellMeta* GetSpellMeta(int spellId)
+{
+	if (spellId <= 0)
+		return nullptr;
+
+	if (s_spellManager != pSpellMgr) {
+		s_spellManager = pSpellMgr;
+		InvalidateSpellCache();
+	}
+
+	auto it = s_spellCache.find(spellId);
+	if (it != s_spellCache.end()) {
+		s_stats.hits++;
+		return it->second.valid ? &it->second.meta : nullptr;
+	}
+
+	s_stats.misses++;
+	CacheEntry& entry = s_spellCache[spellId];
+	s_stats.entries = s_spellCache.size();
+
+	EQ_Spell* spell = GetSpellByID(spellId);
+	if (!spell || spell->ID <= 0)
+		return nullptr;
+
+	entry.valid = true;
+	entry.meta.id = spell->ID;
+	if (spell->Name[0])
+		entry.meta.name = spell->Name;
+	entry.meta.category = spell->Category;
+	entry.meta.detrimental = spell->SpellType == SpellType_Detrimental;
+	for (int classId = 1; classId < SpellMeta::kNumClasses; classId++)
+		entry.meta.level_by_class[classId] = static_cast<int16_t>(spell->GetSpellLevelNeeded(classId));
+	return &entry.meta;
+}
+
+const SpellCacheStats& GetSpellCacheStats()
+{
+	return s_stats;
+}
+
+} // namespace charinfo
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace charinfo {
+
+// Spell data used by the publish and receive paths, resolved once per spell ID.
+struct SpellMeta {
+	static constexpr int kNumClasses = 17;
+
+	int32_t id = 0;
+	std::string name;
+	int32_t category = 0;
+	bool detrimental = false;
+	int16_t level_by_class[kNumClasses] = {};
+
+	int32_t Level(int classId) const
+	{
+		return (classId >= 0 && classId < kNumClasses) ? level_by_class[classId] : 0;
+	}
+};
+
+struct SpellCacheStats {
+	uint64_t hits = 0;
+	uint64_t misses = 0;
+	uint64_t invalidations = 0;
+	size_t entries = 0;
+};
+
+// Cached metadata for spellId, or nullptr if no such spell. The returned pointer (and its name) stays
+// valid until the cache is invalidated.
+const SpellMeta* GetSpellMeta(int spellId);
+
+// Drop every cached entry. Runs automatically when the spell manager is replaced (spell DB reload).
+void InvalidateSpellCache();
+
+const SpellCacheStats& GetSpellCacheStats();
+
+} // namespace charinfo
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <string>
+
+namespace charinfo {
+
+// Outgoing path for serialized CharinfoMessages. The plugin posts through postoffice; senders only
+// see this interface, so another backend (or a stand-in outside the game) can take its place.
+class Transport {
+public:
+	virtual ~Transport() = default;
+
+	// Deliver to every member and listener of `channel` on this server ("" = the default channel).
+	virtual void Broadcast(const std::string& channel, const std::string& wire) = 0;
+
+	// Deliver to one character's mailbox for `channel`.
+	virtual void Send(const std::string& character, const std::string& channel, const std::string& wire) = 0;
+};
+
+} // namespace charinfo
@@ -0,0 +1,49 @@
+/*
+ * MQCharinfo - Routing of our own updates: shared memory, broadcast or the hub.
+ */
+
+#include "UpdateRouting.h"
+
+namespace charinfo {
+
+bool SlotServesMembers(const SharedSnapshots& shared, const PeerMap& peers, const std::string& homeChannel)
+{
+	// Without a slot (shared memory off, no slot free, snapshot too large) nobody can read us.
+	if (!shared.HoldsSlot())
+		return false;
+	bool members = false;
+	for (const auto& [name, peer] : peers) {
+		if (!peer || peer->channel != homeChannel)
+			continue;
+		if (!peer->shared_memory)
+			return false;
+		members = true;
+	}
+	return members;
+}
+
+UpdateRoute RouteUpdate(bool remotePeers, const std::string& hub, const std::string& self)
+{
+	if (!remotePeers)
+		return UpdateRoute::None;
+	if (hub.empty())
+		return UpdateRoute::Broadcast;
+	return hub == self ? UpdateRoute::HubBatch : UpdateRoute::Hub;
+}
+
+bool PostRoutedUpdate(Transport& transport, UpdateRoute route, const std::string& channel, const std::string& hub,
+	const std::string& wire)
+{
+	switch (route) {
+	case UpdateRoute::Broadcast:
+		transport.Broadcast(channel, wire);
+		return true;
+	case UpdateRoute::Hub:
+		transport.Send(hub, channel, wire);
+		return true;
+	default:
+		return false;
+	}
+}
+
+} // namespace charinfo
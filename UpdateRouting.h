@@ -0,0 +1,33 @@
+#pragma once
+
+#include "Charinfo.h"
+#include "SharedSnapshots.h"
+#include "Transport.h"
+
+#include <string>
+
+namespace charinfo {
+
+// Where PostUpdate sends one of our updates.
+enum class UpdateRoute {
+	None,      // every reader takes our shared-memory slot: the update is kept for replays only
+	Broadcast, // to every member and listener of our channel
+	HubBatch,  // we are the hub: into our next batch
+	Hub,       // to the hub, which batches it for everyone
+};
+
+// True if our shared-memory slot serves every member of `homeChannel` in `peers`: we hold a slot,
+// know at least one member, and all of them read us from it. Listeners on other channels are the
+// caller's to check.
+bool SlotServesMembers(const SharedSnapshots& shared, const PeerMap& peers, const std::string& homeChannel);
+
+// The route of an update when `remotePeers` read us by postoffice, under hub `hub` ("" = none)
+// as seen by `self`.
+UpdateRoute RouteUpdate(bool remotePeers, const std::string& hub, const std::string& self);
+
+// Post a serialized update along `route` on `channel`. Returns false when nothing was posted
+// (None, or HubBatch: the batch goes out later).
+bool PostRoutedUpdate(Transport& transport, UpdateRoute route, const std::string& channel, const std::string& hub,
+	const std::string& wire);
+
+} // namespace charinfo
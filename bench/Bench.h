@@ -0,0 +1,46 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace charinfo::bench {
+
+// Heap allocations made so far; BenchMain.cpp replaces the global operator new to count them.
+uint64_t AllocationCount();
+
+// Keeps a result alive so the optimizer cannot drop the work that produced it.
+void Consume(uint64_t value);
+
+struct Result {
+	double ns_per_op = 0;
+	double allocs_per_op = 0;
+};
+
+// Runs fn() `iterations` times after a warm-up pass and returns the mean cost per call.
+template <typename Fn>
+Result Measure(int iterations, Fn&& fn)
+{
+	for (int i = 0; i < iterations / 10 + 1; i++)
+		fn();
+	const uint64_t allocsBefore = AllocationCount();
+	const auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < iterations; i++)
+		fn();
+	const auto elapsed = std::chrono::steady_clock::now() - start;
+	Result result;
+	result.ns_per_op = std::chrono::duration<double, std::nano>(elapsed).count() / iterations;
+	result.allocs_per_op = static_cast<double>(AllocationCount() - allocsBefore) / iterations;
+	return result;
+}
+
+void Report(const char* name, const Result& result);
+
+// One entry per benchmark file; BenchMain.cpp runs them in order.
+void RunEqualityBench();
+void RunPackBench();
+void RunCompressionBench();
+void RunJoinBench();
+void RunHubBench();
+void RunSharedBench();
+
+} // namespace charinfo::bench
@@ -0,0 +1,70 @@
+/*
+ * MQCharinfo bench - Allocation counting, reporting and the benchmark driver.
+ */
+
+#include "Bench.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+std::atomic<uint64_t> s_allocations{0};
+
+} // namespace
+
+void* operator new(std::size_t size)
+{
+	s_allocations.fetch_add(1, std::memory_order_relaxed);
+	if (void* p = std::malloc(size ? size : 1))
+		return p;
+	throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+	std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+	std::free(p);
+}
+
+namespace charinfo::bench {
+
+namespace {
+
+volatile uint64_t s_sink = 0;
+
+} // namespace
+
+uint64_t AllocationCount()
+{
+	return s_allocations.load(std::memory_order_relaxed);
+}
+
+void Consume(uint64_t value)
+{
+	s_sink = s_sink + value;
+}
+
+void Report(const char* name, const Result& result)
+{
+	std::printf("  %-44s %10.1f ns/op %8.2f allocs/op\n", name, result.ns_per_op, result.allocs_per_op);
+}
+
+} // namespace charinfo::bench
+
+int main()
+{
+	charinfo::bench::RunEqualityBench();
+	charinfo::bench::RunPackBench();
+	charinfo::bench::RunCompressionBench();
+	charinfo::bench::RunJoinBench();
+	charinfo::bench::RunHubBench();
+	charinfo::bench::RunSharedBench();
+	return 0;
+}
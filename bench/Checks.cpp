@@ -0,0 +1,377 @@
+/*
+ * MQCharinfo checks - SharedSnapshots on its POSIX backend (shm_open) and the routing of our own
+ * updates through a recording Transport. Exits non-zero on the first failed check group.
+ */
+
+#include "SharedSnapshots.h"
+#include "SharedVitals.h"
+#include "UpdateRouting.h"
+
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace charinfo::checks {
+
+namespace {
+
+// Slot staleness as in SharedSnapshots.cpp.
+constexpr int64_t kStaleMs = 5000;
+
+int s_failures = 0;
+
+#define CHECK(condition) \
+	do { \
+		if (!(condition)) { \
+			std::printf("  FAILED %s:%d: %s\n", __FILE__, __LINE__, #condition); \
+			s_failures++; \
+		} \
+	} while (0)
+
+// A region of our own per check, removed again when it goes out of scope.
+class ScopedRegion {
+public:
+	explicit ScopedRegion(const char* check)
+		: m_name(std::string("MQCharinfo_check_") + check + "_" + std::to_string(getpid()))
+	{
+	}
+	~ScopedRegion() { shm_unlink(("/" + m_name).c_str()); }
+
+	const std::string& name() const { return m_name; }
+
+private:
+	std::string m_name;
+};
+
+struct Visit {
+	std::string character;
+	bool snapshot = false;
+	std::string bytes;
+	SharedVitals vitals;
+};
+
+// Records every visit; `withVitals` answers visits without a snapshot.
+SharedSnapshots::Visitor Recorder(std::vector<Visit>* visits, bool withVitals = true)
+{
+	return [visits, withVitals](const std::string& character, const std::string* bytes, const SharedVitals& vitals) {
+		if (!bytes && !withVitals)
+			return false;
+		Visit visit;
+		visit.character = character;
+		visit.snapshot = bytes != nullptr;
+		if (bytes)
+			visit.bytes = *bytes;
+		visit.vitals = vitals;
+		visits->push_back(visit);
+		return true;
+	};
+}
+
+SharedVitals Vitals(int64_t hp)
+{
+	SharedVitals vitals;
+	vitals.current_hp = hp;
+	vitals.max_hp = 1000;
+	return vitals;
+}
+
+void CheckWriteThenRead()
+{
+	std::printf("Write, then ReadChanged\n");
+	ScopedRegion region("read");
+	SharedSnapshots writer;
+	SharedSnapshots reader;
+	CHECK(writer.Open(region.name()) && reader.Open(region.name()));
+
+	std::vector<Visit> visits;
+	reader.ReadChanged("live_Reader", 1000, Recorder(&visits));
+	CHECK(visits.empty());
+
+	CHECK(writer.Write("live_Alpha", "snapshot-1", Vitals(900), 1000));
+	CHECK(writer.HoldsSlot());
+	reader.ReadChanged("live_Reader", 1000, Recorder(&visits));
+	CHECK(visits.size() == 1);
+	CHECK(!visits.empty() && visits[0].character == "live_Alpha" && visits[0].snapshot
+		&& visits[0].bytes == "snapshot-1" && visits[0].vitals.current_hp == 900);
+
+	// Nothing written since: nothing to visit.
+	visits.clear();
+	reader.ReadChanged("live_Reader", 1000, Recorder(&visits));
+	CHECK(visits.empty());
+
+	// A vitals-only write comes without the snapshot.
+	CHECK(writer.WriteVitals(Vitals(850), 1001));
+	reader.ReadChanged("live_Reader", 1001, Recorder(&visits));
+	CHECK(visits.size() == 1 && !visits[0].snapshot && visits[0].vitals.current_hp == 850);
+
+	// A reader that can't use vitals alone is called again with the snapshot.
+	visits.clear();
+	CHECK(writer.WriteVitals(Vitals(800), 1002));
+	reader.ReadChanged("live_Reader", 1002, Recorder(&visits, false));
+	CHECK(visits.size() == 1 && visits[0].snapshot && visits[0].bytes == "snapshot-1" && visits[0].vitals.current_hp == 800);
+
+	// Our own slot is never visited.
+	visits.clear();
+	CHECK(writer.Write("live_Alpha", "snapshot-2", Vitals(800), 1003));
+	writer.ReadChanged("live_Alpha", 1003, Recorder(&visits));
+	CHECK(visits.empty());
+
+	// A snapshot too large for a slot releases ours.
+	CHECK(!writer.Write("live_Alpha", std::string(64 * 1024, 'x'), Vitals(800), 1004));
+	CHECK(!writer.HoldsSlot());
+	CHECK(!reader.IsLive("live_Alpha", 1004));
+}
+
+// Snapshots whose every byte is the same letter, with the letter's length and HP: a read that
+// mixes two writes shows up as a snapshot with two letters or a length or HP that doesn't match.
+std::string Pattern(int value)
+{
+	const char letter = static_cast<char>('a' + value % 26);
+	return std::string(static_cast<size_t>(200 + (value % 26) * 400), letter);
+}
+
+bool Consistent(const Visit& visit)
+{
+	if (!visit.snapshot || visit.bytes.empty())
+		return false;
+	const int value = visit.bytes[0] - 'a';
+	return visit.bytes == Pattern(value) && visit.vitals.current_hp == value;
+}
+
+void CheckTornReads()
+{
+	std::printf("Reads during concurrent writes\n");
+	ScopedRegion region("torn");
+	SharedSnapshots writer;
+	SharedSnapshots reader;
+	CHECK(writer.Open(region.name()) && reader.Open(region.name()));
+	CHECK(writer.Write("live_Alpha", Pattern(0), Vitals(0), 1000));
+
+	std::atomic<bool> stop{ false };
+	std::thread writing([&] {
+		for (int i = 1; !stop.load(std::memory_order_relaxed); i++)
+			writer.Write("live_Alpha", Pattern(i % 26), Vitals(i % 26), 1000);
+	});
+
+	std::vector<Visit> visits;
+	const auto until = std::chrono::steady_clock::now() + std::chrono::milliseconds(300);
+	size_t torn = 0;
+	size_t delivered = 0;
+	while (std::chrono::steady_clock::now() < until) {
+		visits.clear();
+		reader.ReadChanged("live_Reader", 1000, Recorder(&visits, false));
+		for (const Visit& visit : visits) {
+			delivered++;
+			if (!Consistent(visit))
+				torn++;
+		}
+	}
+	stop = true;
+	writing.join();
+	std::printf("  %zu snapshots delivered during writes\n", delivered);
+	CHECK(delivered > 0);
+	CHECK(torn == 0);
+
+	// A read that kept losing to the writer is retried: the last write still arrives.
+	CHECK(writer.Write("live_Alpha", Pattern(25), Vitals(25), 1000));
+	visits.clear();
+	reader.ReadChanged("live_Reader", 1000, Recorder(&visits, false));
+	CHECK(visits.size() == 1 && Consistent(visits[0]) && visits[0].bytes == Pattern(25));
+}
+
+void CheckStaleSlots()
+{
+	std::printf("Stale slots\n");
+	ScopedRegion region("stale");
+	SharedSnapshots writer;
+	SharedSnapshots reader;
+	CHECK(writer.Open(region.name()) && reader.Open(region.name()));
+	CHECK(writer.Write("live_Alpha", "snapshot", Vitals(900), 1000));
+
+	CHECK(reader.IsLive("live_Alpha", 1000));
+	CHECK(reader.IsLive("live_Alpha", 1000 + kStaleMs));
+	CHECK(!reader.IsLive("live_Alpha", 1000 + kStaleMs + 1));
+	CHECK(!reader.IsLive("live_Beta", 1000));
+
+	// Touch keeps the slot alive without a write.
+	writer.Touch(1000 + kStaleMs);
+	CHECK(reader.IsLive("live_Alpha", 1000 + 2 * kStaleMs));
+
+	// A stale slot is not read.
+	SharedSnapshots late;
+	CHECK(late.Open(region.name()));
+	std::vector<Visit> visits;
+	late.ReadChanged("live_Late", 1000 + 3 * kStaleMs, Recorder(&visits));
+	CHECK(visits.empty());
+
+	// Release empties the slot for everyone at once.
+	writer.Release();
+	CHECK(!writer.HoldsSlot());
+	CHECK(!reader.IsLive("live_Alpha", 1000 + kStaleMs));
+}
+
+void CheckReclaimedSlots()
+{
+	std::printf("Slots reclaimed from clients that went away\n");
+	ScopedRegion region("reclaim");
+	SharedSnapshots reader;
+	CHECK(reader.Open(region.name()));
+
+	// Fill every slot from processes that exit without releasing theirs.
+	for (int i = 0; i < SharedSnapshots::kSlotCount; i++) {
+		const pid_t child = fork();
+		if (child == 0) {
+			SharedSnapshots gone;
+			const bool written = gone.Open(region.name())
+				&& gone.Write("live_Gone" + std::to_string(i), "old-snapshot", Vitals(i), 1000);
+			_exit(written ? 0 : 1);
+		}
+		int status = 0;
+		CHECK(child > 0 && waitpid(child, &status, 0) == child && WIFEXITED(status) && WEXITSTATUS(status) == 0);
+	}
+	std::vector<Visit> visits;
+	reader.ReadChanged("live_Reader", 1000, Recorder(&visits));
+	CHECK(visits.size() == static_cast<size_t>(SharedSnapshots::kSlotCount));
+
+	// No slot is free while they are live.
+	SharedSnapshots writer;
+	CHECK(writer.Open(region.name()));
+	CHECK(!writer.Write("live_New", "new-snapshot", Vitals(1), 1000 + kStaleMs));
+	CHECK(!writer.HoldsSlot());
+
+	// Once stale, one is taken over and nothing of its old owner is read.
+	const int64_t now = 1000 + kStaleMs + 1;
+	CHECK(writer.Write("live_New", "new-snapshot", Vitals(1), now));
+	CHECK(writer.HoldsSlot());
+	visits.clear();
+	reader.ReadChanged("live_Reader", now, Recorder(&visits));
+	CHECK(visits.size() == 1 && visits[0].character == "live_New" && visits[0].snapshot && visits[0].bytes == "new-snapshot");
+	CHECK(reader.IsLive("live_New", now));
+	for (int i = 0; i < SharedSnapshots::kSlotCount; i++)
+		CHECK(!reader.IsLive("live_Gone" + std::to_string(i), now));
+
+	// The vitals that follow go to the new owner's snapshot.
+	visits.clear();
+	CHECK(writer.WriteVitals(Vitals(2), now));
+	reader.ReadChanged("live_Reader", now, Recorder(&visits));
+	CHECK(visits.size() == 1 && visits[0].character == "live_New" && !visits[0].snapshot && visits[0].vitals.current_hp == 2);
+
+	// Released, the slot shows nothing until it is written again.
+	writer.Release();
+	visits.clear();
+	reader.ReadChanged("live_Reader", now, Recorder(&visits));
+	CHECK(visits.empty());
+	CHECK(!reader.IsLive("live_New", now));
+}
+
+// Stands in for postoffice and keeps everything posted.
+class RecordingTransport : public Transport {
+public:
+	struct Post {
+		std::string character; // "" = broadcast
+		std::string channel;
+		std::string wire;
+	};
+
+	void Broadcast(const std::string& channel, const std::string& wire) override { posts.push_back({ std::string(), channel, wire }); }
+	void Send(const std::string& character, const std::string& channel, const std::string& wire) override
+	{
+		posts.push_back({ character, channel, wire });
+	}
+
+	std::vector<Post> posts;
+};
+
+std::shared_ptr<CharinfoPeer> Peer(const std::string& channel, bool sharedMemory)
+{
+	auto peer = std::make_shared<CharinfoPeer>();
+	peer->channel = channel;
+	peer->shared_memory = sharedMemory;
+	return peer;
+}
+
+// PostUpdate's route for one update, posted through `transport` as the plugin does.
+void PostUpdate(const SharedSnapshots& shared, const PeerMap& peers, const std::string& hub, RecordingTransport* transport)
+{
+	const bool remotePeers = !SlotServesMembers(shared, peers, "raid");
+	const UpdateRoute route = RouteUpdate(remotePeers, hub, "live_Self");
+	PostRoutedUpdate(*transport, route, "raid", hub, "update");
+}
+
+void CheckUpdateRouting()
+{
+	std::printf("Update routing\n");
+	ScopedRegion region("routing");
+	SharedSnapshots shared;
+	CHECK(shared.Open(region.name()));
+	RecordingTransport transport;
+
+	PeerMap peers;
+	peers["live_Alpha"] = Peer("raid", true);
+	peers["live_Beta"] = Peer("raid", true);
+	peers["live_Other"] = Peer("elsewhere", false);
+
+	// Every member reads us from shared memory, but we hold no slot yet: post.
+	PostUpdate(shared, peers, std::string(), &transport);
+	CHECK(transport.posts.size() == 1 && transport.posts[0].character.empty() && transport.posts[0].channel == "raid");
+
+	// With our snapshot in a slot nothing is posted.
+	transport.posts.clear();
+	CHECK(shared.Write("live_Self", "snapshot", Vitals(1), 1000));
+	PostUpdate(shared, peers, std::string(), &transport);
+	PostUpdate(shared, peers, "live_Hub", &transport);
+	CHECK(transport.posts.empty());
+
+	// A member that reads us by postoffice: broadcast, or through the hub.
+	peers["live_Gamma"] = Peer("raid", false);
+	PostUpdate(shared, peers, std::string(), &transport);
+	PostUpdate(shared, peers, "live_Hub", &transport);
+	CHECK(transport.posts.size() == 2 && transport.posts[0].character.empty() && transport.posts[1].character == "live_Hub"
+		&& transport.posts[1].channel == "raid");
+
+	// As hub we batch it instead.
+	transport.posts.clear();
+	CHECK(RouteUpdate(true, "live_Self", "live_Self") == UpdateRoute::HubBatch);
+	PostUpdate(shared, peers, "live_Self", &transport);
+	CHECK(transport.posts.empty());
+	peers.erase("live_Gamma");
+
+	// A failed write gives the slot up: posting resumes.
+	CHECK(!shared.Write("live_Self", std::string(64 * 1024, 'x'), Vitals(1), 1001));
+	PostUpdate(shared, peers, std::string(), &transport);
+	CHECK(transport.posts.size() == 1 && transport.posts[0].character.empty());
+
+	// No members known yet: post.
+	transport.posts.clear();
+	CHECK(shared.Write("live_Self", "snapshot", Vitals(1), 1002));
+	PostUpdate(shared, PeerMap(), std::string(), &transport);
+	CHECK(transport.posts.size() == 1);
+}
+
+} // namespace
+
+} // namespace charinfo::checks
+
+int main()
+{
+	using namespace charinfo::checks;
+	CheckWriteThenRead();
+	CheckTornReads();
+	CheckStaleSlots();
+	CheckReclaimedSlots();
+	CheckUpdateRouting();
+	if (s_failures > 0) {
+		std::printf("%d checks failed\n", s_failures);
+		return 1;
+	}
+	std::printf("All checks passed\n");
+	return 0;
+}
@@ -0,0 +1,89 @@
+/*
+ * MQCharinfo bench - Full publish compression: ratio and cost per message with no dictionary, the
+ * hand-written V1 dictionary and the zstd-trained V2 dictionary (user-013).
+ */
+
+#include "Bench.h"
+#include "Compression.h"
+#include "Samples.h"
+
+#include <zstd.h>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace charinfo::bench {
+
+namespace {
+
+// Seeds past the ones train_dictionary.py trains on, so V2 is measured on publishes it has not seen.
+constexpr uint32_t kFirstHeldOutSeed = 1000000;
+constexpr int kMessages = 200;
+
+std::vector<std::string> HeldOutPublishes()
+{
+	std::vector<std::string> wires;
+	mq::proto::charinfo::CharinfoMessage msg;
+	msg.set_id(mq::proto::charinfo::CharinfoMessageId::Publish);
+	for (int i = 0; i < kMessages; i++) {
+		const uint32_t seed = kFirstHeldOutSeed + static_cast<uint32_t>(i);
+		FillSamplePublish(seed, msg.mutable_publish());
+		for (uint32_t step = 0; step < seed % 50; step++)
+			AdvanceSamplePublish(step, msg.mutable_publish());
+		wires.push_back(msg.SerializeAsString());
+	}
+	return wires;
+}
+
+void ReportKind(const char* name, const std::vector<std::string>& wires, mq::proto::charinfo::CompressionKind kind)
+{
+	size_t raw = 0, compressed = 0;
+	std::string frame, inflated;
+	for (const std::string& wire : wires) {
+		raw += wire.size();
+		compressed += CompressPayload(wire, &frame, kind) ? frame.size() : wire.size();
+		if (CompressPayload(wire, &frame, kind) && (!DecompressPayload(frame, &inflated, kind) || inflated != wire))
+			std::printf("  ROUND TRIP FAILED\n");
+	}
+	std::printf("  %-44s %zu -> %zu bytes per publish, ratio %.2f\n", name, raw / wires.size(),
+		compressed / wires.size(), static_cast<double>(raw) / static_cast<double>(compressed));
+
+	size_t next = 0;
+	char label[96];
+	std::snprintf(label, sizeof(label), "%s compress", name);
+	Report(label, Measure(20000, [&] {
+		Consume(CompressPayload(wires[next++ % wires.size()], &frame, kind));
+	}));
+
+	std::vector<std::string> frames;
+	for (const std::string& wire : wires)
+		frames.push_back(CompressPayload(wire, &frame, kind) ? frame : std::string());
+	std::snprintf(label, sizeof(label), "%s decompress", name);
+	Report(label, Measure(20000, [&] {
+		const std::string& f = frames[next++ % frames.size()];
+		Consume(!f.empty() && DecompressPayload(f, &inflated, kind));
+	}));
+}
+
+} // namespace
+
+void RunCompressionBench()
+{
+	std::printf("\nFull publish compression, zstd level 3, %d held-out synthetic publishes (user-013)\n", kMessages);
+	const std::vector<std::string> wires = HeldOutPublishes();
+
+	size_t raw = 0, plain = 0;
+	std::string frame(ZSTD_compressBound(64 * 1024), '\0');
+	for (const std::string& wire : wires) {
+		raw += wire.size();
+		plain += ZSTD_compress(frame.data(), frame.size(), wire.data(), wire.size(), 3);
+	}
+	std::printf("  %-44s %zu -> %zu bytes per publish, ratio %.2f\n", "no dictionary", raw / wires.size(),
+		plain / wires.size(), static_cast<double>(raw) / static_cast<double>(plain));
+
+	ReportKind("V1 hand-written dictionary", wires, mq::proto::charinfo::COMPRESSION_ZSTD_DICT_V1);
+	ReportKind("V2 trained dictionary", wires, mq::proto::charinfo::COMPRESSION_ZSTD_DICT_V2);
+}
+
+} // namespace charinfo::bench
@@ -0,0 +1,72 @@
+/*
+ * MQCharinfo bench - Submessage comparison in BuildUpdatePayload: serialize-and-compare
+ * (before user-007) against the field-by-field helpers in ProtoEquality.h.
+ */
+
+#include "Bench.h"
+#include "ProtoEquality.h"
+#include "Samples.h"
+
+#include <cstdio>
+
+namespace charinfo::bench {
+
+namespace {
+
+using mq::proto::charinfo::CharinfoPublish;
+
+// The comparisons BuildUpdatePayload made before the helpers, in the same order.
+int ChangedBySerialize(const CharinfoPublish& current, const CharinfoPublish& previous)
+{
+	int changed = 0;
+	if (!current.class_info().SerializeAsString().empty() || !previous.class_info().SerializeAsString().empty()) {
+		if (current.class_info().SerializeAsString() != previous.class_info().SerializeAsString())
+			changed++;
+	}
+	if (current.target().SerializeAsString() != previous.target().SerializeAsString()) changed++;
+	if (current.zone().SerializeAsString() != previous.zone().SerializeAsString()) changed++;
+	if (current.experience().SerializeAsString() != previous.experience().SerializeAsString()) changed++;
+	if (current.make_camp().SerializeAsString() != previous.make_camp().SerializeAsString()) changed++;
+	if (current.macro().SerializeAsString() != previous.macro().SerializeAsString()) changed++;
+	if (current.lua().SerializeAsString() != previous.lua().SerializeAsString()) changed++;
+	return changed;
+}
+
+int ChangedByFields(const CharinfoPublish& current, const CharinfoPublish& previous)
+{
+	int changed = 0;
+	if (!ClassInfoEqual(current.class_info(), previous.class_info())) changed++;
+	if (!TargetInfoEqual(current.target(), previous.target())) changed++;
+	if (!ZoneInfoEqual(current.zone(), previous.zone())) changed++;
+	if (!ExperienceInfoEqual(current.experience(), previous.experience())) changed++;
+	if (!MakeCampInfoEqual(current.make_camp(), previous.make_camp())) changed++;
+	if (!MacroInfoEqual(current.macro(), previous.macro())) changed++;
+	if (!LuaInfoEqual(current.lua(), previous.lua())) changed++;
+	return changed;
+}
+
+} // namespace
+
+void RunEqualityBench()
+{
+	constexpr int kIterations = 200000;
+	std::printf("Submessage diff (7 comparisons per pulse, user-007)\n");
+
+	CharinfoPublish previous;
+	CharinfoPublish current;
+	FillSamplePublish(3, &previous);
+	current = previous;
+	if (ChangedBySerialize(current, previous) != ChangedByFields(current, previous))
+		std::printf("  MISMATCH on the unchanged snapshot\n");
+	Report("unchanged, SerializeAsString (before)", Measure(kIterations, [&] { Consume(ChangedBySerialize(current, previous)); }));
+	Report("unchanged, field by field (after)", Measure(kIterations, [&] { Consume(ChangedByFields(current, previous)); }));
+
+	// A combat pulse: the zone coordinates moved, everything else in the submessages held.
+	AdvanceSamplePublish(1, &current);
+	if (ChangedBySerialize(current, previous) != ChangedByFields(current, previous))
+		std::printf("  MISMATCH on the advanced snapshot\n");
+	Report("combat pulse, SerializeAsString (before)", Measure(kIterations, [&] { Consume(ChangedBySerialize(current, previous)); }));
+	Report("combat pulse, field by field (after)", Measure(kIterations, [&] { Consume(ChangedByFields(current, previous)); }));
+}
+
+} // namespace charinfo::bench
@@ -0,0 +1,91 @@
+/*
+ * MQCharinfo bench - Receiver cost of one tick of peer updates: one Update message per peer
+ * (before user-022) against a single hub CharinfoBatch carrying them all.
+ */
+
+#include "Bench.h"
+#include "PackedUpdates.h"
+#include "Samples.h"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace charinfo::bench {
+
+namespace {
+
+using mq::proto::charinfo::CharinfoMessage;
+using mq::proto::charinfo::CharinfoMessageId;
+
+// Every peer changes something each tick: a group in combat at the default 100 ms hub interval.
+constexpr int kTicksPerSecond = 10;
+constexpr int kScalarsPerUpdate = 6;
+
+// Parse one received message and decode every field it carries, as HandleMessage does before
+// ApplyFieldUpdate (which needs the game and is left out).
+uint64_t Receive(const std::string& wire, CharinfoMessage* msg, mq::proto::charinfo::FieldUpdate* field)
+{
+	msg->ParseFromString(wire);
+	uint64_t fields = 0;
+	auto decode = [&](const mq::proto::charinfo::CharinfoUpdate& update) {
+		PackedUpdateReader reader(update.packed());
+		while (reader.Next(field))
+			fields++;
+		fields += static_cast<uint64_t>(update.updates_size());
+	};
+	if (msg->has_update())
+		decode(msg->update());
+	for (const auto& update : msg->batch().updates())
+		decode(update);
+	return fields;
+}
+
+} // namespace
+
+void RunHubBench()
+{
+	constexpr int kIterations = 20000;
+	std::printf("\nOne tick of peer updates at one receiver, %d scalars per update (user-022)\n", kScalarsPerUpdate);
+
+	CharinfoMessage msg;
+	mq::proto::charinfo::FieldUpdate field;
+	for (int peers : {6, 24, 54}) {
+		// What one receiver gets per tick from the other peers.
+		const int senders = peers - 1;
+		std::vector<std::string> direct;
+		CharinfoMessage batch;
+		batch.set_id(CharinfoMessageId::Batch);
+		batch.mutable_batch()->set_sender("live_Hub");
+		for (int i = 0; i < senders; i++) {
+			CharinfoMessage update;
+			update.set_id(CharinfoMessageId::Update);
+			FillSampleUpdate(static_cast<uint32_t>(i * 13), kScalarsPerUpdate, update.mutable_update());
+			update.mutable_update()->set_sender("live_Peer" + std::to_string(i));
+			PackScalarUpdates(update.mutable_update());
+			direct.push_back(update.SerializeAsString());
+			*batch.mutable_batch()->add_updates() = update.update();
+		}
+		const std::string batched = batch.SerializeAsString();
+
+		size_t directBytes = 0;
+		for (const std::string& wire : direct)
+			directBytes += wire.size();
+
+		const Result before = Measure(kIterations / peers + 1, [&] {
+			uint64_t fields = 0;
+			for (const std::string& wire : direct)
+				fields += Receive(wire, &msg, &field);
+			Consume(fields);
+		});
+		const Result after = Measure(kIterations / peers + 1, [&] { Consume(Receive(batched, &msg, &field)); });
+
+		std::printf("  %d peers: per receiver per second, %d updates/s from each peer\n", peers, kTicksPerSecond);
+		std::printf("    direct   %5d messages/s %8zu B/s  %8.1f us/s parsing\n", senders * kTicksPerSecond,
+			directBytes * kTicksPerSecond, before.ns_per_op * kTicksPerSecond / 1000.0);
+		std::printf("    hub      %5d messages/s %8zu B/s  %8.1f us/s parsing\n", kTicksPerSecond,
+			batched.size() * kTicksPerSecond, after.ns_per_op * kTicksPerSecond / 1000.0);
+	}
+}
+
+} // namespace charinfo::bench
@@ -0,0 +1,180 @@
+/*
+ * MQCharinfo bench - Simulated Joined reply traffic: every client broadcasting its full publish
+ * on each Joined (before user-016) against the queued, jittered replies of JoinReplies.h.
+ */
+
+#include "Bench.h"
+#include "JoinReplies.h"
+#include "Samples.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace charinfo::bench {
+
+namespace {
+
+// One full publish arriving at a client.
+struct Delivery {
+	int receiver;
+	int64_t at_ms;
+	size_t bytes;
+};
+
+struct Totals {
+	double posted = 0;
+	double delivered = 0;
+	double bytes = 0;
+	double peak = 0; // most full publishes one client received within any 100 ms
+};
+
+constexpr int64_t kPeakWindowMs = 100;
+constexpr int kTrials = 20;
+
+// Every client replies to each Joined at once, with a broadcast.
+void SimulateBefore(const std::vector<int64_t>& joinAt, const std::vector<size_t>& sizes, std::vector<Delivery>* out, int* posted)
+{
+	const int n = static_cast<int>(sizes.size());
+	for (int joiner = 0; joiner < n; joiner++) {
+		if (joinAt[joiner] < 0)
+			continue;
+		for (int responder = 0; responder < n; responder++) {
+			if (responder == joiner)
+				continue;
+			++*posted;
+			for (int receiver = 0; receiver < n; receiver++)
+				if (receiver != responder)
+					out->push_back({ receiver, joinAt[joiner], sizes[responder] });
+		}
+	}
+}
+
+// Each client queues the joiners, answers them together after the jittered delay and picks
+// broadcast or directed replies with the plugin's own rule.
+void SimulateAfter(const std::vector<int64_t>& joinAt, const std::vector<size_t>& sizes, std::mt19937& rng,
+	std::vector<Delivery>* out, int* posted)
+{
+	const int n = static_cast<int>(sizes.size());
+	std::uniform_int_distribution<int64_t> jitter(0, kJoinReplyJitterMs);
+	std::vector<int> order;
+	for (int joiner = 0; joiner < n; joiner++)
+		if (joinAt[joiner] >= 0)
+			order.push_back(joiner);
+	std::sort(order.begin(), order.end(), [&](int a, int b) { return joinAt[a] < joinAt[b]; });
+
+	for (int responder = 0; responder < n; responder++) {
+		std::vector<int> pending;
+		int64_t flushAt = 0;
+		auto flush = [&]() {
+			if (BroadcastJoinReplies(pending.size(), static_cast<size_t>(n - 1))) {
+				++*posted;
+				for (int receiver = 0; receiver < n; receiver++)
+					if (receiver != responder)
+						out->push_back({ receiver, flushAt, sizes[responder] });
+			} else {
+				for (int joiner : pending) {
+					++*posted;
+					out->push_back({ joiner, flushAt, sizes[responder] });
+				}
+			}
+			pending.clear();
+		};
+		for (int joiner : order) {
+			if (joiner == responder)
+				continue;
+			if (!pending.empty() && joinAt[joiner] >= flushAt)
+				flush();
+			if (pending.empty())
+				flushAt = joinAt[joiner] + kJoinReplyMinDelayMs + jitter(rng);
+			pending.push_back(joiner);
+		}
+		if (!pending.empty())
+			flush();
+	}
+}
+
+double PeakPerWindow(std::vector<Delivery>& deliveries)
+{
+	std::sort(deliveries.begin(), deliveries.end(), [](const Delivery& a, const Delivery& b) {
+		return a.receiver != b.receiver ? a.receiver < b.receiver : a.at_ms < b.at_ms;
+	});
+	size_t peak = 0;
+	size_t first = 0;
+	for (size_t i = 0; i < deliveries.size(); i++) {
+		if (i > 0 && deliveries[i].receiver != deliveries[i - 1].receiver)
+			first = i;
+		while (deliveries[first].at_ms + kPeakWindowMs <= deliveries[i].at_ms)
+			first++;
+		peak = std::max(peak, i - first + 1);
+	}
+	return static_cast<double>(peak);
+}
+
+void Accumulate(std::vector<Delivery>& deliveries, int posted, Totals* totals)
+{
+	totals->posted += static_cast<double>(posted) / kTrials;
+	totals->delivered += static_cast<double>(deliveries.size()) / kTrials;
+	for (const Delivery& d : deliveries)
+		totals->bytes += static_cast<double>(d.bytes) / kTrials;
+	totals->peak += PeakPerWindow(deliveries) / kTrials;
+}
+
+void PrintRow(const char* policy, const Totals& totals)
+{
+	std::printf("    %-8s %8.0f posted %9.0f delivered %9.1f KB delivered  peak %6.1f per client per 100 ms\n",
+		policy, totals.posted, totals.delivered, totals.bytes / 1024.0, totals.peak);
+}
+
+} // namespace
+
+void RunJoinBench()
+{
+	std::printf("\nJoined replies, full publishes of synthetic characters, mean of %d trials (user-016)\n", kTrials);
+	std::mt19937 rng(16);
+	mq::proto::charinfo::CharinfoMessage msg;
+	msg.set_id(mq::proto::charinfo::CharinfoMessageId::Publish);
+
+	for (int clients : {6, 24, 54}) {
+		std::vector<size_t> sizes;
+		for (int i = 0; i < clients; i++) {
+			FillSamplePublish(static_cast<uint32_t>(i), msg.mutable_publish());
+			sizes.push_back(msg.ByteSizeLong());
+		}
+
+		struct Scenario {
+			const char* name;
+			int joiners;       // clients sending Joined
+			int64_t spreadMs;  // their Joined messages arrive spread over this long
+		};
+		const Scenario scenarios[] = {
+			{ "one client joins", 1, 0 },
+			{ "all zone in within 2 s", clients, 2000 },
+			{ "all zone in at once", clients, 0 },
+		};
+		for (const Scenario& scenario : scenarios) {
+			Totals before, after;
+			for (int trial = 0; trial < kTrials; trial++) {
+				std::vector<int64_t> joinAt(static_cast<size_t>(clients), -1);
+				std::uniform_int_distribution<int64_t> arrival(0, scenario.spreadMs);
+				for (int j = 0; j < scenario.joiners; j++)
+					joinAt[static_cast<size_t>(j)] = arrival(rng);
+
+				std::vector<Delivery> deliveries;
+				int posted = 0;
+				SimulateBefore(joinAt, sizes, &deliveries, &posted);
+				Accumulate(deliveries, posted, &before);
+				deliveries.clear();
+				posted = 0;
+				SimulateAfter(joinAt, sizes, rng, &deliveries, &posted);
+				Accumulate(deliveries, posted, &after);
+			}
+			std::printf("  %d clients, %s\n", clients, scenario.name);
+			PrintRow("before", before);
+			PrintRow("after", after);
+		}
+	}
+}
+
+} // namespace charinfo::bench
@@ -0,0 +1,104 @@
+/*
+ * MQCharinfo bench - Scalar field updates as FieldUpdate entries (before user-012) against the
+ * changed-field mask framing in PackedUpdates.cpp: bytes on the wire and encode/decode cost.
+ */
+
+#include "Bench.h"
+#include "PackedUpdates.h"
+#include "Samples.h"
+
+#include <cstdio>
+#include <string>
+
+namespace charinfo::bench {
+
+namespace {
+
+using mq::proto::charinfo::CharinfoUpdate;
+using mq::proto::charinfo::FieldUpdate;
+
+// What a receiver does with the fields before ApplyFieldUpdate: parse, then visit each value.
+uint64_t DecodeFramed(const std::string& wire, CharinfoUpdate* scratch)
+{
+	scratch->ParseFromString(wire);
+	uint64_t sum = 0;
+	for (const FieldUpdate& u : scratch->updates())
+		sum += static_cast<uint64_t>(u.field_id()) + static_cast<uint64_t>(u.i32() + u.i64() + u.bits());
+	return sum;
+}
+
+uint64_t DecodePacked(const std::string& wire, CharinfoUpdate* scratch, FieldUpdate* field)
+{
+	scratch->ParseFromString(wire);
+	uint64_t sum = 0;
+	PackedUpdateReader reader(scratch->packed());
+	while (reader.Next(field))
+		sum += static_cast<uint64_t>(field->field_id()) + static_cast<uint64_t>(field->i32() + field->i64() + field->bits());
+	for (const FieldUpdate& u : scratch->updates())
+		sum += static_cast<uint64_t>(u.field_id());
+	return sum;
+}
+
+} // namespace
+
+void RunPackBench()
+{
+	constexpr int kIterations = 200000;
+	std::printf("\nScalar update framing (user-012)\n");
+
+	CharinfoUpdate update;
+	CharinfoUpdate scratch;
+	FieldUpdate field;
+	std::string wire;
+	for (int fields : {3, 6, 7}) {
+		FillSampleUpdate(7, fields, &update);
+		const std::string framed = update.SerializeAsString();
+		PackScalarUpdates(&update);
+		const std::string packed = update.SerializeAsString();
+		if (DecodeFramed(framed, &scratch) != DecodePacked(packed, &scratch, &field))
+			std::printf("  MISMATCH decoding %d fields\n", fields);
+		std::printf("  %d scalars: %zu bytes as FieldUpdates, %zu bytes packed (%zu of them the packed field)\n",
+			fields, framed.size(), packed.size(), update.packed().size());
+
+		char name[64];
+		uint32_t step = 0;
+		std::snprintf(name, sizeof(name), "%d scalars, encode FieldUpdates (before)", fields);
+		Report(name, Measure(kIterations, [&] {
+			FillSampleUpdate(step++, fields, &update);
+			update.SerializeToString(&wire);
+			Consume(wire.size());
+		}));
+		std::snprintf(name, sizeof(name), "%d scalars, encode packed (after)", fields);
+		Report(name, Measure(kIterations, [&] {
+			FillSampleUpdate(step++, fields, &update);
+			PackScalarUpdates(&update);
+			update.SerializeToString(&wire);
+			Consume(wire.size());
+		}));
+		std::snprintf(name, sizeof(name), "%d scalars, decode FieldUpdates (before)", fields);
+		Report(name, Measure(kIterations, [&] { Consume(DecodeFramed(framed, &scratch)); }));
+		std::snprintf(name, sizeof(name), "%d scalars, decode packed (after)", fields);
+		Report(name, Measure(kIterations, [&] { Consume(DecodePacked(packed, &scratch, &field)); }));
+	}
+
+	// A field id sent twice: the first value is packed and no copy is left in updates.
+	FillSampleUpdate(7, 3, &update);
+	const FieldUpdate first = update.updates(1); // pct_hps
+	FieldUpdate* duplicate = update.add_updates();
+	*duplicate = first;
+	duplicate->set_i32(first.i32() + 1);
+	PackScalarUpdates(&update);
+	PackedUpdateReader reader(update.packed());
+	bool packedFirst = false;
+	while (reader.Next(&field)) {
+		if (field.field_id() == first.field_id())
+			packedFirst = field.i32() == first.i32();
+	}
+	bool leftover = false;
+	for (const FieldUpdate& u : update.updates())
+		leftover |= u.field_id() == first.field_id();
+	if (!packedFirst || leftover)
+		std::printf("  MISMATCH packing a duplicated field id\n");
+}
+
+} // namespace charinfo::bench
@@ -0,0 +1,46 @@
+/*
+ * MQCharinfo bench - Writes synthetic full publishes, serialized as the plugin posts them before
+ * compression, one file each. Input for train_dictionary.py when no captured payloads are at hand.
+ *
+ *   charinfo_samples <dir> <count> [first seed]
+ */
+
+#include "Samples.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+int main(int argc, char** argv)
+{
+	if (argc < 3) {
+		std::fprintf(stderr, "usage: %s <dir> <count> [first seed]\n", argv[0]);
+		return 2;
+	}
+	const std::string dir = argv[1];
+	const int count = std::atoi(argv[2]);
+	const uint32_t first = argc > 3 ? static_cast<uint32_t>(std::strtoul(argv[3], nullptr, 10)) : 0;
+
+	mq::proto::charinfo::CharinfoMessage msg;
+	msg.set_id(mq::proto::charinfo::CharinfoMessageId::Publish);
+	std::string wire;
+	for (int i = 0; i < count; i++) {
+		const uint32_t seed = first + static_cast<uint32_t>(i);
+		charinfo::bench::FillSamplePublish(seed, msg.mutable_publish());
+		// Later publishes of the same character: the state has moved on since it zoned in.
+		for (uint32_t step = 0; step < seed % 50; step++)
+			charinfo::bench::AdvanceSamplePublish(step, msg.mutable_publish());
+		msg.SerializeToString(&wire);
+
+		const std::string path = dir + "/publish_" + std::to_string(seed) + ".bin";
+		FILE* file = std::fopen(path.c_str(), "wb");
+		if (!file || std::fwrite(wire.data(), 1, wire.size(), file) != wire.size()) {
+			std::fprintf(stderr, "cannot write %s\n", path.c_str());
+			if (file)
+				std::fclose(file);
+			return 1;
+		}
+		std::fclose(file);
+	}
+	return 0;
+}
@@ -0,0 +1,205 @@
+/*
+ * MQCharinfo bench - Synthetic but realistically shaped snapshots.
+ */
+
+#include "Samples.h"
+
+#include <string>
+
+namespace charinfo::bench {
+
+namespace {
+
+struct ClassRow {
+	const char* name;
+	const char* short_name;
+	int id;
+};
+
+const ClassRow kClasses[] = {
+	{"Warrior", "WAR", 1}, {"Cleric", "CLR", 2}, {"Paladin", "PAL", 3}, {"Ranger", "RNG", 4},
+	{"Shadow Knight", "SHD", 5}, {"Druid", "DRU", 6}, {"Monk", "MNK", 7}, {"Bard", "BRD", 8},
+	{"Rogue", "ROG", 9}, {"Shaman", "SHM", 10}, {"Necromancer", "NEC", 11}, {"Wizard", "WIZ", 12},
+	{"Magician", "MAG", 13}, {"Enchanter", "ENC", 14}, {"Beastlord", "BST", 15}, {"Berserker", "BER", 16},
+};
+
+struct ZoneRow {
+	const char* name;
+	const char* short_name;
+	int id;
+};
+
+const ZoneRow kZones[] = {
+	{"The Plane of Knowledge", "poknowledge", 202}, {"The Guild Lobby", "guildlobby", 344},
+	{"The Bazaar", "bazaar", 151}, {"Plane of Tranquility", "potranquility", 203},
+	{"Shard's Landing", "shardslanding", 752}, {"Eastern Wastes", "eastwastes", 116},
+	{"The Overthere", "overthere", 93}, {"Dragonscale Hills", "dragonscale", 442},
+};
+
+const char* const kNames[] = {
+	"Aelric", "Brunhild", "Caspian", "Dorwen", "Elspeth", "Fenwick", "Galadrel", "Hroth",
+	"Isolde", "Jorund", "Kaelen", "Lysandra",
+};
+
+const char* const kTargets[] = {
+	"a frost giant scout", "Lord Vyemm", "a restless dervish", "a tundra mammoth", "Kaelen",
+};
+
+const char* const kMacros[] = {"", "kissassist.mac", "muleassist.mac", "autocleric.mac"};
+
+const char* const kScripts[] = {"rgmercs", "lootnscoot", "buttonmaster", "events"};
+
+// Distinct buff spells the samples draw from.
+constexpr int kBuffCount = 24;
+
+uint32_t Mix(uint32_t x)
+{
+	x ^= x >> 16;
+	x *= 0x7feb352du;
+	x ^= x >> 15;
+	x *= 0x846ca68bu;
+	x ^= x >> 16;
+	return x;
+}
+
+} // namespace
+
+void FillSamplePublish(uint32_t seed, mq::proto::charinfo::CharinfoPublish* publish)
+{
+	publish->Clear();
+	const uint32_t h = Mix(seed + 1);
+	const ClassRow& cls = kClasses[h % 16];
+	const ZoneRow& zone = kZones[(h >> 4) % 8];
+	const char* name = kNames[(h >> 8) % 12];
+
+	publish->set_sender(std::string("live_") + name);
+	publish->set_name(name);
+	publish->set_id(1000 + static_cast<int>(h % 5000));
+	publish->set_level(115 + static_cast<int>(h % 11));
+	publish->mutable_class_info()->set_name(cls.name);
+	publish->mutable_class_info()->set_short_name(cls.short_name);
+	publish->mutable_class_info()->set_id(cls.id);
+	publish->set_max_hp(150000 + (h % 90000));
+	publish->set_current_hp(publish->max_hp() * 9 / 10);
+	publish->set_pct_hps(90);
+	publish->set_max_mana(cls.id == 1 || cls.id == 7 || cls.id == 9 || cls.id == 16 ? 0 : 120000);
+	publish->set_current_mana(publish->max_mana() * 3 / 4);
+	publish->set_pct_mana(publish->max_mana() ? 75 : 0);
+	publish->set_max_endurance(60000);
+	publish->set_current_endurance(58000);
+	publish->set_pct_endurance(96);
+
+	const char* target = kTargets[(h >> 12) % 5];
+	publish->mutable_target()->set_name(target);
+	publish->mutable_target()->set_id(2000 + static_cast<int>(h % 700));
+	publish->set_target_hp(64);
+
+	auto* z = publish->mutable_zone();
+	z->set_name(zone.name);
+	z->set_short_name(zone.short_name);
+	z->set_id(zone.id);
+	z->set_x(-412.5f + static_cast<float>(h % 100));
+	z->set_y(1290.25f);
+	z->set_z(-38.0f);
+	z->set_heading(211.0f);
+
+	const int buffs = 12 + static_cast<int>((h >> 16) % 13);
+	for (int i = 0; i < buffs; i++) {
+		const int pick = static_cast<int>((h + i * 7) % kBuffCount);
+		publish->add_buff_spells()->set_id(40000 + pick * 37);
+		publish->add_buff_durations(600 + i * 40);
+		publish->add_buff_expires(5000000 + i * 40000);
+	}
+	for (int i = 0; i < 3; i++) {
+		publish->add_short_buff_spells()->set_id(40000 + static_cast<int>((h + 11 + i) % kBuffCount) * 37);
+		publish->add_short_buff_durations(18);
+		publish->add_short_buff_expires(5018000);
+	}
+	publish->set_free_buff_slots(42 - buffs);
+	for (int i = 0; i < 13; i++)
+		publish->add_gem(45000 + static_cast<int>((h >> 3) % 200) + i * 11);
+
+	publish->set_state_bits(0x10);
+	publish->set_version(2.9f);
+	publish->set_clock_ms(5000000);
+
+	auto* exp = publish->mutable_experience();
+	exp->set_pct_exp(37.25f);
+	exp->set_pct_aa_exp(12.5f);
+	exp->set_total_aa(8000 + static_cast<int>(h % 3000));
+	exp->set_aa_spent(exp->total_aa() - 40);
+	exp->set_aa_unused(40);
+
+	auto* macro = publish->mutable_macro();
+	macro->set_macro_name(kMacros[(h >> 20) % 4]);
+	macro->set_macro_state(macro->macro_name().empty() ? 0 : 1);
+
+	const int scripts = 1 + static_cast<int>((h >> 24) % 3);
+	for (int i = 0; i < scripts; i++) {
+		auto* script = publish->mutable_lua()->add_scripts();
+		const char* scriptName = kScripts[(h + i) % 4];
+		script->set_pid(100 + i);
+		script->set_name(scriptName);
+		script->set_path(std::string("lua/") + scriptName + "/init.lua");
+		script->set_status("RUNNING");
+	}
+	for (int i = 0; i < 5; i++)
+		publish->add_free_inventory(i == 0 ? 0 : 3 + i * 2);
+
+	// Session string keyframe: one token per class, target, zone, macro and Lua string.
+	const int strings = 7 + 2 * scripts;
+	for (int i = 1; i <= strings; i++)
+		publish->add_string_tokens(static_cast<uint32_t>(i));
+
+	auto* pos = publish->mutable_position();
+	pos->set_x(static_cast<int>(z->x() * 10));
+	pos->set_y(static_cast<int>(z->y() * 10));
+	pos->set_z(static_cast<int>(z->z() * 10));
+	pos->set_heading(2110);
+	pos->set_at_ms(5000000);
+}
+
+void AdvanceSamplePublish(uint32_t step, mq::proto::charinfo::CharinfoPublish* publish)
+{
+	const uint32_t h = Mix(step);
+	publish->set_current_hp(publish->max_hp() * (60 + h % 40) / 100);
+	publish->set_pct_hps(static_cast<int>(publish->current_hp() * 100 / publish->max_hp()));
+	if (publish->max_mana()) {
+		publish->set_current_mana(publish->max_mana() * (30 + (h >> 8) % 70) / 100);
+		publish->set_pct_mana(publish->current_mana() * 100 / publish->max_mana());
+	}
+	publish->set_target_hp(static_cast<int>(100 - step % 100));
+	publish->set_casting_spell_id((h & 3) ? 0 : 45000 + static_cast<int>(h % 200));
+	publish->set_clock_ms(publish->clock_ms() + 100);
+	auto* z = publish->mutable_zone();
+	z->set_x(z->x() + 0.5f);
+	z->set_heading(static_cast<float>((h >> 4) % 512));
+	for (int i = 0; i < publish->buff_durations_size(); i++)
+		publish->set_buff_durations(i, publish->buff_durations(i) > 0 ? publish->buff_durations(i) - 1 : 0);
+}
+
+void FillSampleUpdate(uint32_t step, int fields, mq::proto::charinfo::CharinfoUpdate* update)
+{
+	update->Clear();
+	update->set_sender("live_Brunhild");
+	update->set_seq(1000 + step);
+	update->set_clock_ms(5000000 + step * 100);
+	auto add = [update](mq::proto::charinfo::CharinfoFieldId id) {
+		mq::proto::charinfo::FieldUpdate* u = update->add_updates();
+		u->set_field_id(id);
+		return u;
+	};
+	add(mq::proto::charinfo::FIELD_current_hp)->set_i64(187000 - step * 731);
+	add(mq::proto::charinfo::FIELD_pct_hps)->set_i32(88 - static_cast<int>(step % 40));
+	add(mq::proto::charinfo::FIELD_target_hp)->set_i32(64 - static_cast<int>(step % 60));
+	if (fields > 3)
+		add(mq::proto::charinfo::FIELD_current_mana)->set_i32(91000 - static_cast<int>(step) * 410);
+	if (fields > 4)
+		add(mq::proto::charinfo::FIELD_pct_mana)->set_i32(76 - static_cast<int>(step % 30));
+	if (fields > 5)
+		add(mq::proto::charinfo::FIELD_casting_spell_id)->set_i32(45123);
+	if (fields > 6)
+		add(mq::proto::charinfo::FIELD_state_bits)->set_bits(0x10 | 0x100);
+}
+
+} // namespace charinfo::bench
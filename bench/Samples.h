@@ -0,0 +1,23 @@
+#pragma once
+
+#include "charinfo.pb.h"
+
+#include <cstdint>
+
+namespace charinfo::bench {
+
+// A full publish shaped like a real group member's: class, zone and target, a buff list (spell
+// ids only, as sent to 1.8+ peers) with expiries, gems, experience, a macro, a couple of Lua
+// scripts and the session string keyframe. `seed` picks the
+// character, zone and buffs, so different seeds give different but plausible snapshots.
+void FillSamplePublish(uint32_t seed, mq::proto::charinfo::CharinfoPublish* publish);
+
+// Moves the snapshot on by one pulse: vitals, position and a buff timer tick, as between two
+// publishes of a character in combat. Submessages other than zone keep their value.
+void AdvanceSamplePublish(uint32_t step, mq::proto::charinfo::CharinfoPublish* publish);
+
+// An update of the scalars a combat pulse typically changes, as FieldUpdates: HP, target HP, then
+// with more `fields` (up to 7) mana, casting and state bits.
+void FillSampleUpdate(uint32_t step, int fields, mq::proto::charinfo::CharinfoUpdate* update);
+
+} // namespace charinfo::bench
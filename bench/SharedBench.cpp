@@ -0,0 +1,101 @@
+/*
+ * MQCharinfo bench - A vitals-only change between two clients on one machine: the whole snapshot
+ * rewritten to the shared-memory slot and parsed by the reader (before user-023's fix) against the
+ * slot's fixed-layout vitals (SharedSnapshots.cpp, SharedVitals.h).
+ */
+
+#include "Bench.h"
+#include "Samples.h"
+#include "SharedSnapshots.h"
+#include "SharedVitals.h"
+
+#include <cstdio>
+#include <string>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace charinfo::bench {
+
+namespace {
+
+using mq::proto::charinfo::CharinfoPublish;
+
+// A fixed clock: every slot stays live for the whole run.
+constexpr int64_t kNowMs = 1000;
+
+std::string RegionName()
+{
+#ifdef _WIN32
+	return "MQCharinfo_bench";
+#else
+	return "MQCharinfo_bench_" + std::to_string(getpid());
+#endif
+}
+
+} // namespace
+
+void RunSharedBench()
+{
+	constexpr int kIterations = 200000;
+	std::printf("\nShared-memory vitals change, writer and reader (user-023)\n");
+
+	const std::string region = RegionName();
+	SharedSnapshots writer;
+	SharedSnapshots reader;
+	if (!writer.Open(region) || !reader.Open(region)) {
+		std::printf("  shared memory unavailable\n");
+		return;
+	}
+
+	CharinfoPublish publish;
+	FillSamplePublish(3, &publish);
+	std::string bytes;
+	SharedVitals vitals;
+	publish.SerializeToString(&bytes);
+	ToSharedVitals(publish, &vitals);
+	writer.Write(publish.sender(), bytes, vitals, kNowMs);
+	std::printf("  %zu-byte snapshot, %zu-byte vitals\n", bytes.size(), sizeof(SharedVitals));
+
+	CharinfoPublish parsed;
+	SharedVitals applied;
+	uint64_t visits = 0;
+	// The plugin also runs FromPublish and allocates a peer after the parse; not counted here.
+	const SharedSnapshots::Visitor parse = [&](const std::string&, const std::string* data, const SharedVitals&) {
+		if (data && parsed.ParseFromString(*data))
+			visits += static_cast<uint64_t>(parsed.current_hp());
+		return true;
+	};
+	const SharedSnapshots::Visitor patch = [&](const std::string&, const std::string* data, const SharedVitals& read) {
+		if (!data) {
+			applied = read;
+			visits += static_cast<uint64_t>(applied.current_hp);
+		}
+		return true;
+	};
+
+	int64_t hp = publish.current_hp();
+	Report("vitals change, whole snapshot (before)", Measure(kIterations, [&] {
+		publish.set_current_hp(--hp);
+		publish.SerializeToString(&bytes);
+		writer.Write(publish.sender(), bytes, vitals, kNowMs);
+		reader.ReadChanged("live_Reader", kNowMs, parse);
+	}));
+	Report("vitals change, fixed-layout vitals (after)", Measure(kIterations, [&] {
+		publish.set_current_hp(--hp);
+		ToSharedVitals(publish, &vitals);
+		writer.WriteVitals(vitals, kNowMs);
+		reader.ReadChanged("live_Reader", kNowMs, patch);
+	}));
+	Consume(visits);
+
+	writer.Close();
+	reader.Close();
+#ifndef _WIN32
+	shm_unlink(("/" + region).c_str());
+#endif
+}
+
+} // namespace charinfo::bench
@@ -0,0 +1,82 @@
+#!/usr/bin/env python3
+"""Train the zstd dictionary for COMPRESSION_ZSTD_DICT_V2 and write CompressionDictionary.h.
+
+Samples are serialized full publishes, one per file: either payloads captured by the plugin
+(CaptureDir=<dir> in the INI) or synthetic ones written by charinfo_samples.
+
+    train_dictionary.py --samples <dir>
+    train_dictionary.py --sample-writer build-bench/charinfo_samples
+
+The dictionary id is fixed, so retraining on the same samples reproduces the same header. A
+dictionary trained on different samples is a new wire format: give it a new CompressionKind.
+"""
+
+import argparse
+import os
+import subprocess
+import sys
+import tempfile
+
+HEADER = """#pragma once
+
+// Generated by bench/train_dictionary.py from {source}; do not edit.
+// zstd --train --maxdict={maxdict} --dictID={dict_id}
+
+namespace charinfo {{
+
+constexpr unsigned kTrainedDictionaryId = {dict_id};
+
+const unsigned char kTrainedDictionary[] = {{
+{body}
+}};
+
+}} // namespace charinfo
+"""
+
+
+def write_header(dictionary, path, source, maxdict, dict_id):
+    lines = []
+    for i in range(0, len(dictionary), 16):
+        lines.append("\t" + ", ".join("0x%02x" % b for b in dictionary[i:i + 16]) + ",")
+    with open(path, "w", newline="\n") as out:
+        out.write(HEADER.format(source=source, maxdict=maxdict, dict_id=dict_id, body="\n".join(lines)))
+
+
+def main():
+    here = os.path.dirname(os.path.abspath(__file__))
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--samples", help="directory of captured payloads")
+    parser.add_argument("--sample-writer", help="charinfo_samples binary, used when --samples is not given")
+    parser.add_argument("--count", type=int, default=4000, help="synthetic samples to write")
+    parser.add_argument("--maxdict", type=int, default=4096)
+    parser.add_argument("--dict-id", type=int, default=2)
+    parser.add_argument("--zstd", default="zstd")
+    parser.add_argument("--output", default=os.path.join(here, "..", "CompressionDictionary.h"))
+    args = parser.parse_args()
+
+    with tempfile.TemporaryDirectory() as scratch:
+        samples = args.samples
+        source = "captured payloads"
+        if not samples:
+            if not args.sample_writer:
+                parser.error("give --samples or --sample-writer")
+            samples = os.path.join(scratch, "samples")
+            os.mkdir(samples)
+            subprocess.run([args.sample_writer, samples, str(args.count)], check=True)
+            source = "%d synthetic publishes (charinfo_samples)" % args.count
+
+        files = sorted(os.path.join(samples, name) for name in os.listdir(samples))
+        if not files:
+            sys.exit("no samples in %s" % samples)
+        dict_path = os.path.join(scratch, "dictionary")
+        subprocess.run([args.zstd, "--train", *files, "-o", dict_path, "--maxdict=%d" % args.maxdict,
+                        "--dictID=%d" % args.dict_id, "-q"], check=True)
+        with open(dict_path, "rb") as f:
+            dictionary = f.read()
+
+    write_header(dictionary, args.output, source, args.maxdict, args.dict_id)
+    print("%d-byte dictionary from %d samples -> %s" % (len(dictionary), len(files), os.path.normpath(args.output)))
+
+
+if __name__ == "__main__":
+    main()